@@ -0,0 +1,168 @@
+# Packs card images into texture atlas sheets that axmol's SpriteFrameCache can load
+# Requires Pillow (pip install pillow)
+#
+# Frames are named with the exact path used by the deck config, so Card can look up
+# "card/ascension/Abolisher.jpg" in the SpriteFrameCache without knowing about the atlas.
+#
+# Usage (from Content/card):
+#   python pack_atlas.py --name ascension --config ../configs/ascension.txt --card-size 200x340
+#   python pack_atlas.py --name uno --dir uno --prefix card/uno --sprite "card/Card Back 1.png"
+#
+# Output goes to Content/card/atlas: <name>_<n>.png / <name>_<n>.plist sheets and <name>.txt,
+# the frame index listing every sheet for CardAtlas::loadIndex
+
+import argparse
+import os
+import plistlib
+
+from PIL import Image
+
+CONTENT_DIR = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+OUTPUT_DIR = os.path.join(CONTENT_DIR, "card", "atlas")
+PADDING = 2
+
+
+def read_config_sprites(config_path):
+    # front_sprite and back_sprite columns of the [CARD] section, columns split by tabs or spaces
+    sprites = []
+    section = None
+    with open(config_path) as config:
+        for line in config:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            if line.startswith("["):
+                section = line
+                continue
+            if section != "[CARD]":
+                continue
+            columns = line.split()
+            if len(columns) >= 5:
+                sprites.extend(columns[3:5])
+    return sprites
+
+
+def read_dir_sprites(directory, prefix):
+    return [prefix + "/" + name for name in sorted(os.listdir(directory))
+            if name.lower().endswith((".png", ".jpg", ".jpeg"))]
+
+
+def resolve_source(sprite):
+    # Older configs use "cards/..." while the folder on disk is "card/..."
+    for candidate in (sprite, sprite.replace("cards/", "card/", 1)):
+        path = os.path.join(CONTENT_DIR, candidate)
+        if os.path.isfile(path):
+            return path
+    return None
+
+
+def load_images(sprites, card_size):
+    images = []
+    seen = set()
+    for sprite in sprites:
+        if sprite in seen:
+            continue
+        seen.add(sprite)
+        path = resolve_source(sprite)
+        if path is None:
+            print("Missing image: {}".format(sprite))
+            continue
+        image = Image.open(path).convert("RGBA")
+        if card_size:
+            image.thumbnail(card_size, Image.LANCZOS)
+        images.append((sprite, image))
+    return images
+
+
+def pack_shelves(images, sheet_size):
+    # Shelf packing, tallest first; returns a list of sheets, each a list of (name, image, x, y)
+    images = sorted(images, key=lambda item: item[1].height, reverse=True)
+    sheets = []
+    current = []
+    x = y = shelf_height = 0
+    for name, image in images:
+        width, height = image.width + PADDING, image.height + PADDING
+        if x + width > sheet_size:
+            x = 0
+            y += shelf_height
+            shelf_height = 0
+        if y + height > sheet_size and current:
+            sheets.append(current)
+            current = []
+            x = y = shelf_height = 0
+        current.append((name, image, x, y))
+        x += width
+        shelf_height = max(shelf_height, height)
+    if current:
+        sheets.append(current)
+    return sheets
+
+
+def write_sheet(name, index, frames, sheet_size):
+    texture_name = "{}_{}.png".format(name, index)
+    used_width = max(x + image.width for _, image, x, _ in frames)
+    used_height = max(y + image.height for _, image, _, y in frames)
+    sheet = Image.new("RGBA", (used_width, used_height))
+    plist_frames = {}
+    for frame_name, image, x, y in frames:
+        sheet.paste(image, (x, y))
+        plist_frames[frame_name] = {
+            "frame": "{{{{{},{}}},{{{},{}}}}}".format(x, y, image.width, image.height),
+            "offset": "{0,0}",
+            "rotated": False,
+            "sourceColorRect": "{{{{0,0}},{{{},{}}}}}".format(image.width, image.height),
+            "sourceSize": "{{{},{}}}".format(image.width, image.height),
+        }
+    sheet.save(os.path.join(OUTPUT_DIR, texture_name))
+    plist_name = "{}_{}.plist".format(name, index)
+    with open(os.path.join(OUTPUT_DIR, plist_name), "wb") as out:
+        plistlib.dump({
+            "frames": plist_frames,
+            "metadata": {
+                "format": 2,
+                "realTextureFileName": texture_name,
+                "textureFileName": texture_name,
+                "size": "{{{},{}}}".format(used_width, used_height),
+            },
+        }, out)
+    return plist_name
+
+
+def parse_size(text):
+    width, height = text.lower().split("x")
+    return int(width), int(height)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack card images into atlas sheets")
+    parser.add_argument("--name", required=True, help="atlas name, used for output file names")
+    parser.add_argument("--config", action="append", default=[], help="deck config to read [CARD] sprites from")
+    parser.add_argument("--dir", help="pack every image in this directory instead")
+    parser.add_argument("--prefix", default="", help="frame name prefix for --dir, e.g. card/uno")
+    parser.add_argument("--sprite", action="append", default=[], help="extra image path relative to Content")
+    parser.add_argument("--card-size", type=parse_size, help="downscale every image to fit, e.g. 200x340")
+    parser.add_argument("--sheet-size", type=int, default=2048, help="maximum sheet width and height")
+    args = parser.parse_args()
+
+    sprites = []
+    for config in args.config:
+        sprites.extend(read_config_sprites(config))
+    if args.dir:
+        sprites.extend(read_dir_sprites(args.dir, args.prefix or args.dir))
+    sprites.extend(args.sprite)
+
+    images = load_images(sprites, args.card_size)
+    if not os.path.isdir(OUTPUT_DIR):
+        os.makedirs(OUTPUT_DIR)
+
+    plists = [write_sheet(args.name, i, frames, args.sheet_size)
+              for i, frames in enumerate(pack_shelves(images, args.sheet_size))]
+    with open(os.path.join(OUTPUT_DIR, args.name + ".txt"), "w") as index:
+        for plist in plists:
+            index.write("card/atlas/" + plist + "\n")
+
+    print("Packed {} images into {} sheet(s) for {}".format(len(images), len(plists), args.name))
+
+
+if __name__ == "__main__":
+    main()
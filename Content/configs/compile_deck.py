@@ -0,0 +1,79 @@
+# Compiles a tab separated deck config (e.g. ascension.txt) into the binary deck format read by DeckFile
+#
+# Usage (from Content/configs):
+#   python compile_deck.py ascension.txt ascension.deck
+#
+# Layout, little endian, see Source/core/object/data/DeckFile.h:
+#   header   magic "CDCK", u16 version, u16 header size, u32 record count, u32 record size,
+#            u32 records offset, u32 string table offset, u32 string table size,
+#            u32 byte order mark 0x01020304, so a reader of the other endianness rejects the file
+#   records  one fixed size record per [CARD] line
+#   strings  every distinct sprite path once, null terminated, records refer to them by offset
+
+import struct
+import sys
+
+MAGIC = b"CDCK"
+VERSION = 2
+BYTE_ORDER_MARK = 0x01020304
+HEADER = struct.Struct("<4sHHIIIIII")
+RECORD = struct.Struct("<iffIIfffI")
+
+
+class StringTable:
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def intern(self, text):
+        if text not in self.offsets:
+            self.offsets[text] = len(self.data)
+            self.data += text.encode("utf-8") + b"\0"
+        return self.offsets[text]
+
+
+def read_cards(config_path):
+    # [CARD] columns: id pos_x pos_y front_sprite back_sprite size_x size_y rotation amount, split by tabs or spaces
+    cards = []
+    section = None
+    with open(config_path) as config:
+        for line_number, line in enumerate(config, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            if line.startswith("["):
+                section = line
+                continue
+            if section != "[CARD]":
+                continue
+            columns = line.split()
+            if len(columns) != 9:
+                raise ValueError("{}:{}: expected 9 columns, got {}".format(config_path, line_number, len(columns)))
+            cards.append(columns)
+    return cards
+
+
+def compile_deck(config_path, output_path):
+    strings = StringTable()
+    records = bytearray()
+    cards = read_cards(config_path)
+    for card_id, pos_x, pos_y, front, back, size_x, size_y, rotation, amount in cards:
+        records += RECORD.pack(int(card_id), float(pos_x), float(pos_y), strings.intern(front), strings.intern(back),
+                               float(size_x), float(size_y), float(rotation), int(amount))
+
+    records_offset = HEADER.size
+    strings_offset = records_offset + len(records)
+    with open(output_path, "wb") as out:
+        out.write(HEADER.pack(MAGIC, VERSION, HEADER.size, len(cards), RECORD.size, records_offset,
+                              strings_offset, len(strings.data), BYTE_ORDER_MARK))
+        out.write(records)
+        out.write(strings.data)
+
+    print("Compiled {} cards and {} distinct sprites into {}".format(len(cards), len(strings.offsets), output_path))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("Usage: python compile_deck.py <config.txt> <output.deck>")
+        sys.exit(1)
+    compile_deck(sys.argv[1], sys.argv[2])
@@ -3,6 +3,7 @@
 #include "core/scene/MenuScene.h"
 #include "core/scene/RoomScene.h"
 #include "core/scene/LoginScene.h"
+#include "core/object/CardFaceManager.h"
 
 #define USE_AUDIO_ENGINE 1
 
@@ -71,6 +72,9 @@ void AppDelegate::applicationDidEnterBackground()
 {
     Director::getInstance()->stopAnimation();
 
+    // Hidden card fronts are cheap to reload, give the memory back while in the background
+    CardFaceManager::getInstance()->purgeUnused();
+
 #if USE_AUDIO_ENGINE
     AudioEngine::pauseAll();
 #endif
@@ -7,9 +7,10 @@ EventCard::EventCard(Card* card, bool isFlipped)
     , _isCardFlipped(isFlipped)
 {}
 
-EventCard::EventCard(Card* card, ax::Vec2 releasePosition)
+EventCard::EventCard(Card* card, ax::Vec2 releasePosition, Zone* targetZone)
     : EventCustom(EventListenerCard::LISTENER_ID)
     , card(card)
     , _releasePosition(releasePosition)
+    , _targetZone(targetZone)
     , _isCardFlipped(false) 
 {}
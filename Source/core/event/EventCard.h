@@ -2,21 +2,25 @@
 
 #include "axmol.h"
 #include "core/object/Card.h"
+#include "EventCounter.h"
 
-class AX_DLL EventCard : public ax::EventCustom
+// Dispatch from the stack, the dispatcher does not keep the event
+class AX_DLL EventCard : public ax::EventCustom, public EventCounter<EventCard>
 {
 public:
     EventCard(Card* card, bool isFlipped);
-    EventCard(Card* card, ax::Vec2 releasePosition);
+    EventCard(Card* card, ax::Vec2 releasePosition, Zone* targetZone = nullptr);
 
     bool isFlipped() const { return _isCardFlipped; }
     ax::Vec2 getReleasePosition() const { return _releasePosition; }
     Card* getCard() const { return card; }
+    Zone* getTargetZone() const { return _targetZone; }
 
 private:
     Card* card;  // The card associated with this event
     bool _isCardFlipped;  // Whether the card is flipped or not
     ax::Vec2 _releasePosition;  // Position where the card was released (for drag-and-drop)
+    Zone* _targetZone = nullptr;  // Topmost unlocked zone under the release position, resolved by the InputRouter
 
     friend class EventListenerCard;
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+
+// Debug-only instance counters for custom events. Events are dispatched from the stack, so the live count
+// should drop back to zero after every dispatch; anything else is a leaked event.
+template <typename T>
+class EventCounter
+{
+public:
+#if defined(_AX_DEBUG) && _AX_DEBUG > 0
+    EventCounter() { ++_live; ++_created; }
+    EventCounter(const EventCounter&) { ++_live; ++_created; }
+    ~EventCounter() { --_live; }
+
+    static int getLiveCount() { return _live; }
+    static long long getCreatedCount() { return _created; }
+
+private:
+    static inline std::atomic<int> _live{0};
+    static inline std::atomic<long long> _created{0};
+#else
+    static int getLiveCount() { return 0; }
+    static long long getCreatedCount() { return 0; }
+#endif
+};
@@ -7,7 +7,7 @@ const std::string EventListenerWebSocket::LISTENER_ID = "__ax_websocket";
 
 bool EventListenerWebSocket::checkAvailable()
 {
-    if (onWebSocketMessage == nullptr || onWebSocketOpen == nullptr || onWebSocketError == nullptr || onWebSocketClose == nullptr)
+    if (onWebSocketOpen == nullptr || onWebSocketError == nullptr || onWebSocketClose == nullptr)
     {
         AXASSERT(false, "Invalid EventListenerWebSocket!");
         return false;
@@ -36,10 +36,10 @@ EventListenerWebSocket* EventListenerWebSocket::clone()
     if (ret->init())
     {
         ret->autorelease();
-        ret->onWebSocketMessage = onWebSocketMessage;
-        ret->onWebSocketOpen    = onWebSocketOpen;
-        ret->onWebSocketError   = onWebSocketError;
-        ret->onWebSocketClose   = onWebSocketClose;
+        ret->onWebSocketOpen   = onWebSocketOpen;
+        ret->onWebSocketError  = onWebSocketError;
+        ret->onWebSocketClose  = onWebSocketClose;
+        ret->onWebSocketResync = onWebSocketResync;
     }
     else
     {
@@ -48,7 +48,9 @@ EventListenerWebSocket* EventListenerWebSocket::clone()
     return ret;
 }
 
-EventListenerWebSocket::EventListenerWebSocket() : onWebSocketMessage(nullptr), onWebSocketOpen(nullptr), onWebSocketError(nullptr), onWebSocketClose(nullptr) {}
+EventListenerWebSocket::EventListenerWebSocket()
+    : onWebSocketOpen(nullptr), onWebSocketError(nullptr), onWebSocketClose(nullptr), onWebSocketResync(nullptr)
+{}
 
 bool EventListenerWebSocket::init()
 {
@@ -56,10 +58,6 @@ bool EventListenerWebSocket::init()
         auto webSocketEvent = static_cast<EventWebSocket*>(event);
         switch (webSocketEvent->_eventType)
         {
-        case EventWebSocket::WebSocketEventType::MESSAGE:
-            if (onWebSocketMessage != nullptr)
-                onWebSocketMessage(webSocketEvent);
-            break;
         case EventWebSocket::WebSocketEventType::OPEN:
             if (onWebSocketOpen != nullptr)
                 onWebSocketOpen(webSocketEvent);
@@ -74,6 +72,10 @@ bool EventListenerWebSocket::init()
             if (onWebSocketClose != nullptr)
                 onWebSocketClose(webSocketEvent);
             break;
+        case EventWebSocket::WebSocketEventType::RESYNC:
+            if (onWebSocketResync != nullptr)
+                onWebSocketResync(webSocketEvent);
+            break;
         default:
             break;
         }   
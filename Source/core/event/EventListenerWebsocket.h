@@ -14,10 +14,10 @@ public:
     virtual EventListenerWebSocket* clone() override;
     virtual bool checkAvailable() override;
 
-    std::function<void(EventWebSocket*)> onWebSocketMessage;
     std::function<void(EventWebSocket*)> onWebSocketOpen;
     std::function<void(EventWebSocket*)> onWebSocketError;
     std::function<void(EventWebSocket*)> onWebSocketClose;
+    std::function<void(EventWebSocket*)> onWebSocketResync;  // Optional
 
     EventListenerWebSocket();
     bool init();
@@ -1,9 +1,7 @@
 #include "EventWebSocket.h"
 #include "EventListenerWebSocket.h"
 
-EventWebSocket::EventWebSocket(const WebSocketEventType eventType, const json& data)
+EventWebSocket::EventWebSocket(const WebSocketEventType eventType)
     : EventCustom(EventListenerWebSocket::LISTENER_ID) 
     , _eventType(eventType)
-    , _data(data)
 {}
-
@@ -3,30 +3,28 @@
 #include "axmol.h"
 
 #include <string>
-#include "utils/json.hpp"
+#include "EventCounter.h"
 
-using json = lib::json;
-
-class AX_DLL EventWebSocket : public ax::EventCustom
+// Connection changes of the game socket, messages go through MessageRouter.
+// Dispatch from the stack, the dispatcher does not keep the event
+class AX_DLL EventWebSocket : public ax::EventCustom, public EventCounter<EventWebSocket>
 {
 public:
     enum class WebSocketEventType
     {
-        MESSAGE,
         OPEN,
         CLOSE,
+        RESYNC,  // Messages meant for us were lost while disconnected, rebuild what they would have changed
 #undef ERROR
         ERROR
 #define ERROR 0
     };
 
-    EventWebSocket(const WebSocketEventType eventType, const json& data = json());
+    explicit EventWebSocket(const WebSocketEventType eventType);
 
-    json getData() const { return _data; }
     WebSocketEventType getEventType() const { return _eventType; }
 
 private:
-    json _data;
     WebSocketEventType _eventType;
     
     friend class EventListenerWebSocket;
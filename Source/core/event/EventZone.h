@@ -3,8 +3,10 @@
 #include "axmol.h"
 #include "core/object/Zone.h"
 #include "core/object/Card.h"
+#include "EventCounter.h"
 
-class AX_DLL EventZone : public ax::EventCustom
+// Dispatch from the stack, the dispatcher does not keep the event
+class AX_DLL EventZone : public ax::EventCustom, public EventCounter<EventZone>
 {
 public:
     EventZone(Zone* zone, Card* card = nullptr);
@@ -0,0 +1,12 @@
+#pragma once
+
+class ITickable
+{
+
+public:
+    // Advance by one logic step, either from a frame update or as fast as a headless loop can go
+    virtual void tick() = 0;
+
+    virtual ~ITickable() = default;
+
+};
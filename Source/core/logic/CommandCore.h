@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+
+// Axmol-free command state, shared by the scene graph Command and headless simulations
+class CommandCore
+{
+public:
+    virtual ~CommandCore() {}
+    virtual void execute() {};
+    virtual void undo() {};
+    virtual void step() {};  // Advance a running command by one engine tick, headless commands finish here
+    virtual bool needsStep() const { return false; }  // Commands driven by step() keep their unit awake while running
+    virtual bool isDone() const { return _isDone; }
+    virtual bool isRunning() const { return _isRunning; }
+    virtual void setDone(bool isDone)
+    {
+        _isDone = isDone;
+        if (_isDone && _onCompleteCallback)
+        {
+            _onCompleteCallback();
+        }
+    }
+    virtual void setRunning(bool isRunning) { _isRunning = isRunning; }
+
+    void setOnCompleteCallback(std::function<void()> callback) { _onCompleteCallback = callback; }
+
+protected:
+    bool _isDone    = false;
+    bool _isRunning = false;
+    std::function<void()> _onCompleteCallback = nullptr;  // Callback to be called when the command is complete
+};
@@ -0,0 +1,110 @@
+#include "CommandHistory.h"
+
+#include <algorithm>
+
+CommandHistory::CommandHistory(TableState& table, size_t depth) : _table(table), _steps(std::max<size_t>(depth, 1)) {}
+
+void CommandHistory::setCard(int32_t cardId, const CardState& state)
+{
+    if (cardId < 0 || size_t(cardId) >= _table.getCardCount())
+        return;
+    auto change = std::find_if(_open.begin(), _open.end(),
+                               [cardId](const CardChange& change) { return change.cardId == cardId; });
+    if (change == _open.end())
+        _open.push_back({cardId, _table.getCard(cardId), state});
+    else
+        change->after = state;
+    _table.setCard(cardId, state);
+}
+
+uint32_t CommandHistory::commit()
+{
+    // Cards that ended where they started are not part of the step
+    _open.erase(std::remove_if(_open.begin(), _open.end(),
+                               [](const CardChange& change) { return change.before == change.after; }),
+                _open.end());
+    if (_open.empty())
+        return 0;
+
+    _size = _cursor;
+    if (_size == _steps.size())
+    {
+        _first = (_first + 1) % _steps.size();
+        --_size;
+    }
+    auto& step = stepAt(_size);
+    step.id    = ++_lastStepId;
+    step.changes.swap(_open);
+    _open.clear();
+    _cursor = ++_size;
+    return step.id;
+}
+
+bool CommandHistory::revert(uint32_t stepId)
+{
+    commit();
+    size_t index = 0;
+    while (index < _cursor && stepAt(index).id != stepId)
+        ++index;
+    if (index == _cursor)
+        return false;
+
+    auto& step = stepAt(index);
+    for (auto change = step.changes.rbegin(); change != step.changes.rend(); ++change)
+    {
+        if (_table.getCard(change->cardId) == change->after)
+            _table.setCard(change->cardId, change->before);
+    }
+
+    // The later steps close the gap, anything undone goes as it does on commit
+    for (size_t i = index; i + 1 < _cursor; ++i)
+        std::swap(stepAt(i), stepAt(i + 1));
+    _size = --_cursor;
+    return true;
+}
+
+bool CommandHistory::undo()
+{
+    commit();
+    if (_cursor == 0)
+        return false;
+    auto& step = stepAt(--_cursor);
+    for (auto change = step.changes.rbegin(); change != step.changes.rend(); ++change)
+        _table.setCard(change->cardId, change->before);
+    return true;
+}
+
+bool CommandHistory::redo()
+{
+    commit();
+    if (_cursor == _size)
+        return false;
+    auto& step = stepAt(_cursor++);
+    for (auto& change : step.changes)
+        _table.setCard(change.cardId, change.after);
+    return true;
+}
+
+void CommandHistory::setDepth(size_t depth)
+{
+    depth = std::max<size_t>(depth, 1);
+    if (_size > depth)
+        _size = std::max(_cursor, depth);
+    size_t dropped = _size > depth ? _size - depth : 0;
+
+    std::vector<Step> steps(depth);
+    for (size_t i = 0; i + dropped < _size; ++i)
+        std::swap(steps[i], stepAt(i + dropped));
+    _steps  = std::move(steps);
+    _first  = 0;
+    _size  -= dropped;
+    _cursor -= dropped;
+}
+
+void CommandHistory::clear()
+{
+    _open.clear();
+    _first  = 0;
+    _size   = 0;
+    _cursor = 0;
+}
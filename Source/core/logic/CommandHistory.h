@@ -0,0 +1,64 @@
+#pragma once
+
+#include "TableState.h"
+
+#include <cstdint>
+#include <vector>
+
+// One card's part of a step: enough to put it back, or to do the step again
+struct CardChange
+{
+    int32_t cardId = -1;
+    CardState before;
+    CardState after;
+};
+
+// Undo and redo over a TableState without copying it. Commands change cards through setCard, and
+// commit closes everything changed since into one step holding only the touched cards. Steps live
+// in a ring buffer of getDepth() slots, the oldest is dropped once it is full. Undo and redo write
+// through TableState::setCard, so the /state deltas pick them up like any other change.
+class CommandHistory
+{
+public:
+    static constexpr size_t DEFAULT_DEPTH = 64;
+
+    explicit CommandHistory(TableState& table, size_t depth = DEFAULT_DEPTH);
+
+    // Applies the change now and adds it to the open step, a card changed twice keeps one entry
+    void setCard(int32_t cardId, const CardState& state);
+
+    // Closes the open step and returns its id, 0 if it left the table as it was. Throws away
+    // anything undone.
+    uint32_t commit();
+    // Takes one done step back, leaving the steps after it in place: its cards return to where they
+    // were, except those changed again since. False when the step is undone or no longer held.
+    bool revert(uint32_t stepId);
+
+    // Both close the open step first, false when there is nothing to undo or redo
+    bool undo();
+    bool redo();
+
+    bool canUndo() const { return _cursor > 0 || !_open.empty(); }
+    bool canRedo() const { return _cursor < _size && _open.empty(); }
+
+    size_t getDepth() const { return _steps.size(); }
+    void setDepth(size_t depth);  // Shrinking drops undone steps first, then the oldest ones
+    void clear();                 // Forgets every step, the table stays as it is
+
+private:
+    struct Step
+    {
+        uint32_t id = 0;
+        std::vector<CardChange> changes;
+    };
+
+    Step& stepAt(size_t index) { return _steps[(_first + index) % _steps.size()]; }
+
+    TableState& _table;
+    std::vector<Step> _steps;  // Slots keep their capacity when reused
+    std::vector<CardChange> _open;
+    size_t _first  = 0;  // Slot of the oldest step
+    size_t _size   = 0;  // Steps held, done and undone
+    size_t _cursor = 0;  // Steps before it are done, from it on undone
+    uint32_t _lastStepId = 0;
+};
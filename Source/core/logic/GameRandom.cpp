@@ -0,0 +1,72 @@
+#include "GameRandom.h"
+
+#include <numeric>
+#include <random>
+
+namespace
+{
+uint64_t rotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t splitMix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+}  // namespace
+
+void GameRandom::seed(uint64_t seedValue)
+{
+    _seed      = seedValue;
+    auto state = seedValue;
+    for (auto& word : _state)
+        word = splitMix64(state);
+}
+
+uint64_t GameRandom::next()
+{
+    auto result = rotateLeft(_state[1] * 5, 7) * 9;
+    auto t      = _state[1] << 17;
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = rotateLeft(_state[3], 45);
+    return result;
+}
+
+uint32_t GameRandom::nextBelow(uint32_t bound)
+{
+    // Lemire's multiply and reject, unbiased and without a division on the common path
+    auto product = uint64_t(uint32_t(next() >> 32)) * bound;
+    auto low     = uint32_t(product);
+    if (low < bound)
+    {
+        auto threshold = uint32_t(-bound) % bound;
+        while (low < threshold)
+        {
+            product = uint64_t(uint32_t(next() >> 32)) * bound;
+            low     = uint32_t(product);
+        }
+    }
+    return uint32_t(product >> 32);
+}
+
+std::vector<int> GameRandom::shuffleOrder(int count)
+{
+    std::vector<int> order(count > 0 ? count : 0);
+    std::iota(order.begin(), order.end(), 0);
+    shuffle(order.begin(), order.end());
+    return order;
+}
+
+uint64_t GameRandom::makeSeed()
+{
+    std::random_device device;
+    return (uint64_t(device()) << 32) ^ device();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Per-game random stream, xoshiro256** seeded through splitmix64. The same seed gives the same
+// draws on every platform and compiler (no std distributions), so client and server only share
+// the 64-bit seed and a game can be replayed exactly.
+class GameRandom
+{
+public:
+    GameRandom() { seed(0); }
+    explicit GameRandom(uint64_t seedValue) { seed(seedValue); }
+
+    void seed(uint64_t seedValue);
+    uint64_t getSeed() const { return _seed; }
+
+    uint64_t next();
+    // Uniform in [0, bound), bound must be above 0
+    uint32_t nextBelow(uint32_t bound);
+
+    // Fisher-Yates over any random access range
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last)
+    {
+        auto count = std::distance(first, last);
+        for (auto i = count - 1; i > 0; --i)
+        {
+            auto j = nextBelow(uint32_t(i + 1));
+            using std::swap;
+            swap(first[i], first[j]);
+        }
+    }
+
+    // The card index at each deck position for a deck of count cards
+    std::vector<int> shuffleOrder(int count);
+
+    // A fresh seed from the system entropy source, for starting a new game
+    static uint64_t makeSeed();
+
+private:
+    uint64_t _seed = 0;
+    uint64_t _state[4];
+};
@@ -0,0 +1,92 @@
+#include "LogicEngine.h"
+#include "Schedulable.h"
+
+#include <algorithm>
+
+LogicEngine::~LogicEngine()
+{
+    clear();
+}
+
+void LogicEngine::add(Schedulable* schedulable)
+{
+    if (!_registered.insert(schedulable).second)
+        return;
+    schedulable->setEngine(this);
+    wake(schedulable);
+}
+
+void LogicEngine::remove(Schedulable* schedulable)
+{
+    if (_registered.erase(schedulable) == 0)
+        return;
+    unwatch(schedulable);
+    if (_queued.erase(schedulable) > 0)
+        _readyQueue.erase(std::remove(_readyQueue.begin(), _readyQueue.end(), schedulable), _readyQueue.end());
+    schedulable->setEngine(nullptr);
+}
+
+void LogicEngine::clear()
+{
+    for (auto schedulable : _registered)
+        schedulable->setEngine(nullptr);
+    _registered.clear();
+    _readyQueue.clear();
+    _queued.clear();
+    _watchers.clear();
+}
+
+void LogicEngine::wake(Schedulable* schedulable)
+{
+    if (_registered.count(schedulable) == 0)
+        return;
+    if (_queued.insert(schedulable).second)
+        _readyQueue.push_back(schedulable);
+}
+
+void LogicEngine::watch(Schedulable* schedulable, int stateKey)
+{
+    auto& watchers = _watchers[stateKey];
+    if (std::find(watchers.begin(), watchers.end(), schedulable) == watchers.end())
+        watchers.push_back(schedulable);
+}
+
+void LogicEngine::unwatch(Schedulable* schedulable)
+{
+    for (auto& [key, watchers] : _watchers)
+        watchers.erase(std::remove(watchers.begin(), watchers.end(), schedulable), watchers.end());
+}
+
+void LogicEngine::notifyStateChanged(int stateKey)
+{
+    auto it = _watchers.find(stateKey);
+    if (it == _watchers.end())
+        return;
+    for (auto schedulable : it->second)
+        wake(schedulable);
+}
+
+void LogicEngine::step()
+{
+    // Only what is queued now, anything woken during this step runs on the next one
+    size_t count = _readyQueue.size();
+    for (size_t i = 0; i < count && !_readyQueue.empty(); ++i)
+    {
+        Schedulable* schedulable = _readyQueue.front();
+        _readyQueue.pop_front();
+        _queued.erase(schedulable);
+        schedulable->tick();
+    }
+    ++_stepCount;
+}
+
+size_t LogicEngine::runToCompletion(size_t maxSteps)
+{
+    size_t steps = 0;
+    while (steps < maxSteps && !isIdle())
+    {
+        step();
+        ++steps;
+    }
+    return steps;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Schedulable;
+
+// Event-driven scheduler for rule objects. Nothing is polled: an object only ticks after it was woken by
+// a completed command or a watched state change, so idle flows cost nothing per frame.
+// Objects are not owned, the caller keeps them alive for as long as they are registered.
+class LogicEngine
+{
+public:
+    static const int COMMAND_COMPLETED = -1;  // State key notified whenever any command of this engine completes
+
+    ~LogicEngine();
+
+    void add(Schedulable* schedulable);  // Registers and wakes once
+    void remove(Schedulable* schedulable);
+    void clear();
+
+    void wake(Schedulable* schedulable);
+    void watch(Schedulable* schedulable, int stateKey);
+    void unwatch(Schedulable* schedulable);
+    void notifyStateChanged(int stateKey);
+
+    void step();  // Tick everything that was woken before this call, in wake order
+    size_t runToCompletion(size_t maxSteps = std::numeric_limits<size_t>::max());  // Returns the number of steps taken
+    bool isIdle() const { return _readyQueue.empty(); }
+
+    size_t getStepCount() const { return _stepCount; }
+
+protected:
+    std::unordered_set<Schedulable*> _registered;
+    std::deque<Schedulable*> _readyQueue;
+    std::unordered_set<Schedulable*> _queued;  // Mirrors _readyQueue so a wake is never queued twice
+    std::unordered_map<int, std::vector<Schedulable*>> _watchers;
+    size_t _stepCount = 0;
+};
@@ -0,0 +1,142 @@
+#include "LogicUnitCore.h"
+#include "LogicEngine.h"
+
+LogicUnitCore* LogicUnitCore::_currentLogicUnit = nullptr;  // pointer to singleton
+
+LogicUnitCore::LogicUnitCore(CommandCore* command, LogicUnitCore* next) : _next(next)
+{
+    setCommand(command);
+}
+
+void LogicUnitCore::setCommand(CommandCore* command)
+{
+    _command = command;
+    _command->setOnCompleteCallback([this]() {
+        onCommandComplete();
+    });
+}
+
+void LogicUnitCore::start()
+{
+    _currentLogicUnit = this;
+    setRunning(true);
+    _command->execute();
+    if (_command->needsStep())
+        wake();
+}
+
+void LogicUnitCore::run() {}
+
+void LogicUnitCore::end() {}
+
+void LogicUnitCore::onCommandComplete()
+{
+    setDone(true);
+    wake();
+    if (_engine)
+        _engine->notifyStateChanged(LogicEngine::COMMAND_COMPLETED);
+}
+
+void LogicUnitCore::tick()
+{
+    conditionsCheckAndStart();
+    if (!isRunning())
+        return;
+    if (!isDone() && _command->needsStep())
+    {
+        _command->step();
+        if (!isDone())
+            wake();
+    }
+    if (isDone())
+        startNext();
+}
+
+void LogicUnitCore::setEngine(LogicEngine* engine)
+{
+    Schedulable::setEngine(engine);
+    updateWatches();
+}
+
+void LogicUnitCore::setConditionList(const std::vector<std::function<bool()>>& conditions)
+{
+    _conditionList = conditions;
+    updateWatches();
+}
+
+void LogicUnitCore::watchState(int stateKey)
+{
+    _watchedStates.push_back(stateKey);
+    updateWatches();
+}
+
+void LogicUnitCore::updateWatches()
+{
+    if (!_engine)
+        return;
+    _engine->unwatch(this);
+    if (_conditionList.empty())
+        return;
+    if (_watchedStates.empty())
+    {
+        _engine->watch(this, LogicEngine::COMMAND_COMPLETED);
+        return;
+    }
+    for (int stateKey : _watchedStates)
+        _engine->watch(this, stateKey);
+}
+
+void LogicUnitCore::conditionsCheckAndStart()
+{
+    if (_conditionList.empty())
+        return;
+
+    bool allConditionsMet = true;
+    for (const auto& condition : _conditionList)
+    {
+        if (!condition())
+        {
+            allConditionsMet = false;
+            break;
+        }
+    }
+    if (allConditionsMet)
+    {
+        _previous = LogicUnitCore::getCurrentLogicUnit();
+        start();
+    }
+}
+
+void LogicUnitCore::reset()
+{
+    _isRunning = false;
+    _isDone    = false;
+    if (_command)
+    {
+        _command->setDone(false);
+        _command->setRunning(false);
+    }
+}
+
+void LogicUnitCore::resetChain()
+{
+    reset();
+    if (_next)
+    {
+        _next->resetChain();
+    }
+}
+
+void LogicUnitCore::startNext()
+{
+    if (_isDone && _next)
+    {
+        _next->_previous = this;
+        _isRunning       = false;
+        if (isAutoReset())
+        {
+            reset();
+        }
+        _next->start();
+    }
+}
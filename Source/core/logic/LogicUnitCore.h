@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "CommandCore.h"
+#include "Schedulable.h"
+
+class LogicUnitCore : public Schedulable
+{
+public:
+    LogicUnitCore(CommandCore* command, LogicUnitCore* next);
+    virtual ~LogicUnitCore() {}
+    static LogicUnitCore* getCurrentLogicUnit() { return _currentLogicUnit; }
+
+    void start();
+    void run();
+    void end();
+    void tick() override;
+    void setEngine(LogicEngine* engine) override;
+
+    void setCommand(CommandCore* command);
+    CommandCore* getCommand() const { return _command; }
+    void setNext(LogicUnitCore* next) { _next = next; }
+    LogicUnitCore* getNext() const { return _next; }
+
+    // Conditions are only evaluated when a watched state key changes, or after any command completes
+    // when no key is watched
+    void setConditionList(const std::vector<std::function<bool()>>& conditions);
+    void watchState(int stateKey);
+    void conditionsCheckAndStart();
+
+    void setDone(bool isDone) { _isDone = isDone; }
+    bool isDone() const { return _isDone; }
+    void setRunning(bool isRunning) { _isRunning = isRunning; }
+    virtual bool isRunning() const { return _isRunning; }
+
+    void setIsConditional(bool isConditional) { _isConditional = isConditional; }
+    bool isConditional() const { return _isConditional; }
+    void setIsSelfLoop(bool isSelfLoop) { _isSelfLoop = isSelfLoop; }
+    bool isSelfLoop() const { return _isSelfLoop; }
+    void setIsAutoReset(bool isAutoReset) { _isAutoReset = isAutoReset; }
+    bool isAutoReset() const { return _isAutoReset; }
+
+    void reset();
+    void resetChain();
+
+    void startNext();
+
+protected:
+    void onCommandComplete();
+    void updateWatches();
+
+    static LogicUnitCore* _currentLogicUnit;  // Static pointer to keep track of the currently running logic unit
+
+    CommandCore* _command = nullptr;
+
+    LogicUnitCore* _next     = nullptr;
+    LogicUnitCore* _previous = nullptr;
+
+    std::vector<std::function<bool()>> _conditionList = std::vector<std::function<bool()>>();  // For conditional logic units, store the conditions to check
+    std::vector<int> _watchedStates;
+
+    bool _isRunning = false;
+    bool _isDone    = false;
+
+    bool _isConditional = false;  // Can be jump to if conditions are met
+    bool _isSelfLoop    = false;
+    bool _isAutoReset   = false;
+};
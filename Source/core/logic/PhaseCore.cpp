@@ -0,0 +1,70 @@
+#include "PhaseCore.h"
+
+PhaseCore::PhaseCore(const std::vector<CommandCore*>& commandList, bool isRepeating)
+    : _commandList(commandList), _isRepeating(isRepeating)
+{
+    for (auto command : _commandList)
+    {
+        command->setOnCompleteCallback([this]() {
+            wake();
+        });
+    }
+}
+
+void PhaseCore::startPhase()
+{
+    _isStarted = true;
+    wake();
+}
+
+void PhaseCore::executeCommand()
+{
+    if (_currentCommandIndex >= _commandList.size())
+        return;
+    auto command = _commandList[_currentCommandIndex];
+    if (command && !command->isDone() && !command->isRunning())
+    {
+        command->execute();
+    }
+}
+
+void PhaseCore::tick()
+{
+    if (!_isStarted || _isDone)
+        return;
+
+    // Skip every command that already finished, including ones that completed inside execute()
+    while (_currentCommandIndex < _commandList.size() && _commandList[_currentCommandIndex]->isDone())
+    {
+        _currentCommandIndex++;
+        executeCommand();
+    }
+
+    if (_currentCommandIndex < _commandList.size())
+    {
+        auto command = _commandList[_currentCommandIndex];
+        executeCommand();
+        if (command->needsStep() && !command->isDone())
+        {
+            command->step();
+            wake();
+        }
+    }
+    else if (!_isRepeating)
+    {
+        _isDone = true;
+        if (_onCompleteCallback)
+            _onCompleteCallback();
+    }
+    else
+    {
+        // Restart on the next step so a phase of instant commands cannot spin inside one tick
+        _currentCommandIndex = 0;
+        for (auto command : _commandList)
+        {
+            command->setDone(false);
+            command->setRunning(false);
+        }
+        wake();
+    }
+}
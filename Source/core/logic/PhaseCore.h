@@ -0,0 +1,35 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "CommandCore.h"
+#include "Schedulable.h"
+
+class PhaseCore : public Schedulable
+{
+    enum class State {
+        prepare,
+        main,
+        done
+    };
+
+public:
+    PhaseCore(const std::vector<CommandCore*>& commandList, bool isRepeating = false);
+    virtual ~PhaseCore() {}
+    virtual void startPhase();
+    void executeCommand();
+    void tick() override;
+    bool isDone() const { return _isDone; }
+
+    void setOnCompleteCallback(std::function<void()> callback) { _onCompleteCallback = callback; }
+
+protected:
+    std::vector<CommandCore*> _commandList;
+    size_t _currentCommandIndex = 0;
+    State _currentState         = State::prepare;
+    bool _isStarted             = false;
+    bool _isDone                = false;
+    bool _isRepeating           = false;  // Flag to indicate if the phase should repeat after completion
+    std::function<void()> _onCompleteCallback = nullptr;
+};
@@ -0,0 +1,149 @@
+#include "ReplayLog.h"
+
+#include <chrono>
+#include <cstring>
+
+ReplayWriter::~ReplayWriter()
+{
+    close();
+}
+
+bool ReplayWriter::open(const std::string& path)
+{
+    close();
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file)
+        return false;
+
+    uint8_t header[replay::HEADER_SIZE] = {};
+    std::memcpy(header, replay::MAGIC, sizeof(replay::MAGIC));
+    header[4] = replay::VERSION;
+    std::fwrite(header, 1, sizeof(header), _file);
+
+    _isClosing = false;
+    _thread    = std::thread(&ReplayWriter::run, this);
+    return true;
+}
+
+void ReplayWriter::close()
+{
+    if (!_file)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isClosing = true;
+    }
+    _wake.notify_one();
+    _thread.join();
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+void ReplayWriter::recordSeed(uint64_t seed)
+{
+    _frame.clear();
+    wire::encodeSeed(_frame, seed);
+    append(_frame);
+}
+
+void ReplayWriter::recordDeal(std::span<const wire::DealEntry> entries)
+{
+    _frame.clear();
+    wire::encodeDeal(_frame, entries);
+    append(_frame);
+}
+
+void ReplayWriter::recordMove(int32_t playerId, int32_t cardId)
+{
+    _frame.clear();
+    wire::encodeMove(_frame, {playerId, cardId});
+    append(_frame);
+}
+
+void ReplayWriter::append(const std::vector<uint8_t>& frame)
+{
+    if (!_file)
+        return;
+    bool isFull;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.insert(_pending.end(), frame.begin(), frame.end());
+        isFull = _pending.size() >= FLUSH_BYTES;
+    }
+    if (isFull)
+        _wake.notify_one();
+}
+
+void ReplayWriter::run()
+{
+    std::vector<uint8_t> writing;
+    bool isClosing = false;
+    while (!isClosing)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS),
+                           [this] { return _isClosing || _pending.size() >= FLUSH_BYTES; });
+            isClosing = _isClosing;
+            writing.swap(_pending);
+        }
+        // The game thread only waits for the swap, never for the disk
+        if (!writing.empty())
+        {
+            std::fwrite(writing.data(), 1, writing.size(), _file);
+            std::fflush(_file);
+            writing.clear();
+        }
+    }
+}
+
+bool ReplayReader::load(const std::string& path)
+{
+    auto file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        _error = "Cannot open " + path;
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[64 * 1024];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+        bytes.insert(bytes.end(), chunk, chunk + read);
+    std::fclose(file);
+    return load(std::move(bytes));
+}
+
+bool ReplayReader::load(std::vector<uint8_t>&& bytes)
+{
+    _bytes = std::move(bytes);
+    _error.clear();
+    if (_bytes.size() < replay::HEADER_SIZE || std::memcmp(_bytes.data(), replay::MAGIC, sizeof(replay::MAGIC)) != 0)
+    {
+        _error = "Not a replay file";
+        return false;
+    }
+    if (_bytes[4] != replay::VERSION)
+    {
+        _error = "Unsupported replay version " + std::to_string(_bytes[4]);
+        return false;
+    }
+    rewind();
+    return true;
+}
+
+bool ReplayReader::next(wire::Header& header, std::span<const uint8_t>& payload)
+{
+    if (_offset >= _bytes.size())
+        return false;
+    auto rest = std::span<const uint8_t>(_bytes).subspan(_offset);
+    if (!wire::decodeFrame(rest, header, payload))
+    {
+        // A game that crashed mid-write leaves a truncated last record, everything before it is still good
+        _error  = "Damaged record at byte " + std::to_string(_offset);
+        _offset = _bytes.size();
+        return false;
+    }
+    _offset += wire::HEADER_SIZE + header.payloadSize;
+    return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "core/network/protocol/WireProtocol.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Replay files: an 8 byte header ("CRPL", u8 version, 3 reserved bytes) followed by the game's
+// records as wire frames back to back, the same encoding the game sends over the socket:
+// SEED once, DEAL once, then one MOVE per played card.
+namespace replay
+{
+constexpr char MAGIC[4]      = {'C', 'R', 'P', 'L'};
+constexpr uint8_t VERSION    = 1;
+constexpr size_t HEADER_SIZE = 8;
+}  // namespace replay
+
+// Appends records from the game thread and writes them on its own thread. Records reach the file
+// every FLUSH_INTERVAL_MS, or sooner once FLUSH_BYTES have piled up, and on close.
+class ReplayWriter
+{
+public:
+    static constexpr int FLUSH_INTERVAL_MS = 1000;
+    static constexpr size_t FLUSH_BYTES    = 16 * 1024;
+
+    ReplayWriter() = default;
+    ~ReplayWriter();
+    ReplayWriter(const ReplayWriter&)            = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    bool open(const std::string& path);
+    void close();  // Writes what is left and waits for the writer thread
+    bool isOpen() const { return _file != nullptr; }
+
+    void recordSeed(uint64_t seed);
+    void recordDeal(std::span<const wire::DealEntry> entries);
+    void recordMove(int32_t playerId, int32_t cardId);
+
+private:
+    void append(const std::vector<uint8_t>& frame);
+    void run();
+
+    std::FILE* _file = nullptr;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::vector<uint8_t> _pending;  // Filled by the game thread, swapped out by the writer
+    std::vector<uint8_t> _frame;    // Game thread scratch, keeps its capacity between records
+    bool _isClosing = false;
+};
+
+// Reads a whole replay into memory and walks its records in order without copying them
+class ReplayReader
+{
+public:
+    bool load(const std::string& path);
+    bool load(std::vector<uint8_t>&& bytes);
+
+    // The next record, false at the end or on a damaged record (see getError)
+    bool next(wire::Header& header, std::span<const uint8_t>& payload);
+    void rewind() { _offset = replay::HEADER_SIZE; }
+
+    const std::string& getError() const { return _error; }
+
+private:
+    std::vector<uint8_t> _bytes;
+    size_t _offset = 0;
+    std::string _error;
+};
@@ -0,0 +1,161 @@
+#include "Replayer.h"
+#include "CommandCore.h"
+#include "LogicEngine.h"
+#include "LogicUnitCore.h"
+#include "GameRandom.h"
+
+#include <algorithm>
+#include <memory>
+
+// A headless command that applies one record and completes straight away
+class Replayer::RecordCommand : public CommandCore
+{
+public:
+    RecordCommand(Replayer* replayer, const wire::Header& header, std::span<const uint8_t> payload,
+                  ReplayTarget* target)
+        : _replayer(replayer), _header(header), _payload(payload), _target(target)
+    {}
+
+    void execute() override
+    {
+        setRunning(true);
+        _replayer->apply(_header, _payload, _target);
+        setDone(true);
+    }
+
+private:
+    Replayer* _replayer;
+    wire::Header _header;
+    std::span<const uint8_t> _payload;  // Views the reader's bytes
+    ReplayTarget* _target;
+};
+
+bool Replayer::load(const std::string& path)
+{
+    return _reader.load(path);
+}
+
+bool Replayer::load(std::vector<uint8_t>&& bytes)
+{
+    return _reader.load(std::move(bytes));
+}
+
+bool Replayer::run(ReplayTarget* target)
+{
+    _summary   = ReplaySummary();
+    _hasSeed   = false;
+    _lastMover = -1;
+    _reader.rewind();
+
+    std::vector<std::unique_ptr<RecordCommand>> commands;
+    wire::Header header;
+    std::span<const uint8_t> payload;
+    while (_reader.next(header, payload))
+        commands.push_back(std::make_unique<RecordCommand>(this, header, payload, target));
+    if (commands.empty())
+        return _reader.getError().empty();
+
+    // Chain the records back to front so each unit starts the next when its command completes
+    std::vector<std::unique_ptr<LogicUnitCore>> units(commands.size());
+    for (size_t i = commands.size(); i-- > 0;)
+        units[i] = std::make_unique<LogicUnitCore>(commands[i].get(), i + 1 < units.size() ? units[i + 1].get() : nullptr);
+
+    LogicEngine engine;
+    for (auto& unit : units)
+        engine.add(unit.get());
+    units.front()->start();
+    engine.runToCompletion();
+    engine.clear();
+
+    return _reader.getError().empty();
+}
+
+void Replayer::apply(const wire::Header& header, std::span<const uint8_t> payload, ReplayTarget* target)
+{
+    switch (header.type)
+    {
+    case wire::MessageType::SEED:
+        if (!wire::decodeSeed(payload, _summary.seed))
+            break;
+        _hasSeed = true;
+        if (target)
+            target->onSeed(_summary.seed);
+        break;
+    case wire::MessageType::DEAL:
+    {
+        wire::DealMessage deal;
+        if (!wire::decodeDeal(payload, deal))
+            break;
+        // The deck order the seed gives, the count is bounded by the payload size
+        std::vector<int> order;
+        if (_hasSeed)
+            order = GameRandom(_summary.seed).shuffleOrder(int(deal.count));
+        else
+            desync("deal without a seed to check it against");
+        wire::DealEntry entry;
+        for (uint32_t i = 0; i < deal.count && wire::readDealEntry(deal.entries, entry); ++i)
+        {
+            if (_hasSeed)
+                checkDeal(i, entry, order);
+            if (entry.cardId < 0)
+                continue;
+            if (size_t(entry.cardId) >= _summary.cardZones.size())
+                _summary.cardZones.resize(entry.cardId + 1, -1);
+            _summary.cardZones[entry.cardId] = entry.zoneIndex;
+            if (target)
+                target->onDeal(entry.cardId, entry.zoneIndex);
+        }
+        break;
+    }
+    case wire::MessageType::MOVE:
+    {
+        wire::MoveMessage move;
+        if (!wire::decodeMove(payload, move))
+            break;
+        if (move.cardId < 0 || size_t(move.cardId) >= _summary.cardZones.size())
+        {
+            desync("player " + std::to_string(move.playerId) + " played card " + std::to_string(move.cardId) +
+                   ", which was never dealt");
+            break;
+        }
+        checkMove(move);
+        _lastMover                      = move.playerId;
+        _summary.cardZones[move.cardId] = PLAY_FIELD_ZONE;
+        _summary.moves.push_back(move);
+        if (target)
+            target->onMove(move.playerId, move.cardId);
+        if (_summary.winner == -1 &&
+            std::find(_summary.cardZones.begin(), _summary.cardZones.end(), move.playerId) == _summary.cardZones.end())
+            _summary.winner = move.playerId;
+        break;
+    }
+    default:
+        break;  // Records from a newer client, skipped
+    }
+}
+
+void Replayer::checkDeal(uint32_t position, const wire::DealEntry& entry, const std::vector<int>& order)
+{
+    int32_t zoneIndex = int32_t(position % HAND_COUNT);
+    if (entry.cardId == order[position] && entry.zoneIndex == zoneIndex)
+        return;
+    desync("deal " + std::to_string(position) + " gives card " + std::to_string(entry.cardId) + " to zone " +
+           std::to_string(entry.zoneIndex) + ", the seed gives card " + std::to_string(order[position]) +
+           " to zone " + std::to_string(zoneIndex));
+}
+
+void Replayer::checkMove(const wire::MoveMessage& move)
+{
+    auto player = std::to_string(move.playerId);
+    if (move.playerId == _lastMover)
+        desync("player " + player + " moved twice in a row");
+    else if (auto zoneIndex = _summary.cardZones[move.cardId]; zoneIndex != move.playerId)
+        desync("player " + player + " played card " + std::to_string(move.cardId) + " from zone " +
+               std::to_string(zoneIndex) + ", not their hand");
+}
+
+void Replayer::desync(std::string what)
+{
+    if (_summary.desync.empty())
+        _summary.desync = std::move(what);
+}
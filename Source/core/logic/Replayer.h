@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ReplayLog.h"
+#include "TableState.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Receives each record as the replayer executes it. A visual replay implements it to put the
+// scene's cards where the record says, without animating.
+class ReplayTarget
+{
+public:
+    virtual ~ReplayTarget() {}
+    virtual void onSeed(uint64_t /*seed*/) {}
+    virtual void onDeal(int32_t /*cardId*/, int32_t /*zoneIndex*/) {}
+    virtual void onMove(int32_t /*playerId*/, int32_t /*cardId*/) {}
+};
+
+// What a replayed game came to, for desync reports and statistics across many games
+struct ReplaySummary
+{
+    uint64_t seed = 0;
+    std::vector<int32_t> cardZones;  // Zone index by card id, -1 for a card never dealt
+    std::vector<wire::MoveMessage> moves;
+    int32_t winner = -1;  // The first player to empty their hand, -1 for an unfinished game
+    std::string desync;   // The first record the rules disagree with, empty when every record checked out
+};
+
+// Re-executes a replay through the rule chain: one LogicUnitCore per record, run by a LogicEngine
+// at full speed with no scene, clock or network. Records are checked, not just copied: a DEAL has
+// to match the order GameRandom derives from the game's SEED, dealt alternately into the hands,
+// and a MOVE has to come from the player whose turn it is and play a card from their hand.
+// Records that fail still apply, the first one is reported in ReplaySummary::desync.
+class Replayer
+{
+public:
+    static constexpr int32_t PLAY_FIELD_ZONE = TableState::PLAY_FIELD_ZONE;
+    static constexpr int32_t HAND_COUNT      = 2;  // Card i of the shuffled deck goes to hand i % HAND_COUNT
+
+    bool load(const std::string& path);
+    bool load(std::vector<uint8_t>&& bytes);
+
+    // Runs every record, false if the log ends in a damaged record (the summary covers the records before it)
+    bool run(ReplayTarget* target = nullptr);
+
+    const ReplaySummary& getSummary() const { return _summary; }
+    const std::string& getError() const { return _reader.getError(); }
+
+private:
+    class RecordCommand;
+
+    void apply(const wire::Header& header, std::span<const uint8_t> payload, ReplayTarget* target);
+    void checkDeal(uint32_t position, const wire::DealEntry& entry, const std::vector<int>& order);
+    void checkMove(const wire::MoveMessage& move);
+    void desync(std::string what);  // Keeps the first
+
+    ReplayReader _reader;
+    ReplaySummary _summary;
+    bool _hasSeed      = false;
+    int32_t _lastMover = -1;  // Player of the previous move, -1 before the first
+};
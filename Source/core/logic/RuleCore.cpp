@@ -0,0 +1,37 @@
+#include "RuleCore.h"
+
+RuleCore::RuleCore(TurnCore* startTurn, TurnCore* mainTurn, TurnCore* endTurn)
+    : _startTurn(startTurn), _mainTurn(mainTurn), _endTurn(endTurn)
+{
+    _currentTurn = _startTurn;
+    for (auto turn : {_startTurn, _mainTurn, _endTurn})
+    {
+        if (turn)
+        {
+            turn->setOnCompleteCallback([this]() {
+                wake();
+            });
+        }
+    }
+}
+
+void RuleCore::tick()
+{
+    if (_currentTurn && _currentTurn->isDone()) {
+        switch (_currentState) {
+            case State::start:
+                _currentTurn = _mainTurn;
+                executeTurn();
+                _currentState = State::main;
+                break;
+            case State::main:
+                _currentTurn = _endTurn;
+                executeTurn();
+                _currentState = State::end;
+                break;
+            case State::end:
+                // Rule is done, you might want to reset or do something else here
+                break;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "TurnCore.h"
+#include "Schedulable.h"
+
+class RuleCore : public Schedulable
+{
+    enum class State {
+        start,
+        main,
+        end
+    };
+
+public:
+    RuleCore(TurnCore* startTurn, TurnCore* mainTurn, TurnCore* endTurn);
+    virtual ~RuleCore() {}
+
+    void startRule() {
+        executeTurn();
+    }
+
+    void executeTurn() {
+        if (_currentTurn) {
+            _currentTurn->startTurn();
+        }
+    }
+
+    void tick() override;
+
+protected:
+    TurnCore* _startTurn;
+    TurnCore* _mainTurn;
+    TurnCore* _endTurn;
+    TurnCore* _currentTurn = nullptr;
+
+    State _currentState = State::start;
+
+};
@@ -0,0 +1,14 @@
+#include "Schedulable.h"
+#include "LogicEngine.h"
+
+Schedulable::~Schedulable()
+{
+    if (_engine)
+        _engine->remove(this);
+}
+
+void Schedulable::wake()
+{
+    if (_engine)
+        _engine->wake(this);
+}
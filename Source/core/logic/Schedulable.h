@@ -0,0 +1,20 @@
+#pragma once
+
+#include "core/interface/ITickable.h"
+
+class LogicEngine;
+
+// Base for anything the LogicEngine schedules. Objects sleep until something wakes them.
+class Schedulable : public ITickable
+{
+public:
+    virtual ~Schedulable();
+
+    virtual void setEngine(LogicEngine* engine) { _engine = engine; }
+    LogicEngine* getEngine() const { return _engine; }
+
+    void wake();  // Queue a tick on the next engine step
+
+protected:
+    LogicEngine* _engine = nullptr;
+};
@@ -0,0 +1,76 @@
+#include "TableState.h"
+
+#include <algorithm>
+
+void TableState::reset(size_t cardCount)
+{
+    ++_version;
+    _resetVersion = _version;
+    _cards.assign(cardCount, CardState());
+    _changedAt.assign(cardCount, _version);
+}
+
+int32_t TableState::countInZone(int32_t zoneIndex) const
+{
+    return int32_t(std::count_if(_cards.begin(), _cards.end(),
+                                 [zoneIndex](const CardState& card) { return card.zoneIndex == zoneIndex; }));
+}
+
+void TableState::setCard(int32_t cardId, const CardState& state)
+{
+    if (cardId < 0 || size_t(cardId) >= _cards.size() || _cards[cardId] == state)
+        return;
+    _cards[cardId]     = state;
+    _changedAt[cardId] = ++_version;
+}
+
+void TableState::encodeSince(std::vector<uint8_t>& out, uint32_t sinceVersion) const
+{
+    bool isSnapshot = sinceVersion == 0 || sinceVersion < _resetVersion || sinceVersion > _version;
+    std::vector<wire::CardDelta> deltas;
+    for (size_t cardId = 0; cardId < _cards.size(); ++cardId)
+    {
+        if (!isSnapshot && _changedAt[cardId] <= sinceVersion)
+            continue;
+        auto& card = _cards[cardId];
+        deltas.push_back({int32_t(cardId), card.zoneIndex, card.order, card.owner, card.isFaceUp});
+    }
+    wire::encodeStateDelta(out, isSnapshot ? 0 : sinceVersion, _version, deltas);
+}
+
+bool TableState::apply(std::span<const uint8_t> payload, std::vector<int32_t>* changedCards)
+{
+    wire::StateDeltaMessage message;
+    if (!wire::decodeStateDelta(payload, message))
+        return false;
+    bool isSnapshot = message.fromVersion == 0;
+    if (!isSnapshot && message.fromVersion != _version)
+        return false;  // Built on a version we do not have, ask again from ours
+
+    // Read everything first, a damaged message must not leave half of it applied
+    std::vector<wire::CardDelta> deltas(message.count);
+    for (auto& delta : deltas)
+        if (!wire::readCardDelta(message.entries, delta) || delta.cardId < 0)
+            return false;
+
+    if (isSnapshot)
+    {
+        _cards.assign(deltas.size(), CardState());
+        _changedAt.assign(deltas.size(), message.toVersion);
+        _resetVersion = message.toVersion;
+    }
+    for (auto& delta : deltas)
+    {
+        if (size_t(delta.cardId) >= _cards.size())
+        {
+            _cards.resize(delta.cardId + 1);
+            _changedAt.resize(delta.cardId + 1, message.toVersion);
+        }
+        _cards[delta.cardId]     = {delta.zoneIndex, delta.order, delta.owner, delta.isFaceUp};
+        _changedAt[delta.cardId] = message.toVersion;
+        if (changedCards)
+            changedCards->push_back(delta.cardId);
+    }
+    _version = message.toVersion;
+    return true;
+}
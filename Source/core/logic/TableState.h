@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/network/protocol/WireProtocol.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct CardState
+{
+    int32_t zoneIndex = -1;  // -1 while the card is in no zone
+    int32_t order     = 0;   // Position inside the zone
+    int32_t owner     = -1;
+    bool isFaceUp     = false;
+
+    bool operator==(const CardState&) const = default;
+};
+
+// Plain-data table: where every card is, by card id. Every change bumps the version and stamps the
+// card with it, so a delta from any earlier version is one scan with one entry per changed card,
+// however often it changed in between. Deltas and snapshots travel as wire STATE_DELTA messages.
+class TableState
+{
+public:
+    static constexpr int32_t PLAY_FIELD_ZONE = 2;  // Player hands are zones 0 and 1, as GameScene deals them
+
+    // A new game. Versions keep counting up, a client still on the old game gets a snapshot.
+    void reset(size_t cardCount);
+
+    uint32_t getVersion() const { return _version; }
+    size_t getCardCount() const { return _cards.size(); }
+    const CardState& getCard(int32_t cardId) const { return _cards[cardId]; }
+    int32_t countInZone(int32_t zoneIndex) const;
+
+    // Bumps the version unless nothing changed
+    void setCard(int32_t cardId, const CardState& state);
+
+    // The changes after sinceVersion, or a snapshot when sinceVersion is 0, older than the last reset
+    // or newer than this state
+    void encodeSince(std::vector<uint8_t>& out, uint32_t sinceVersion) const;
+
+    // Applies a snapshot, or a delta whose fromVersion is this state's version. Otherwise returns false
+    // and leaves the state alone. changedCards receives the card ids the message touched.
+    bool apply(std::span<const uint8_t> payload, std::vector<int32_t>* changedCards = nullptr);
+
+private:
+    std::vector<CardState> _cards;
+    std::vector<uint32_t> _changedAt;  // Version of each card's last change
+    uint32_t _version      = 0;
+    uint32_t _resetVersion = 0;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+
+#include "PhaseCore.h"
+#include "Schedulable.h"
+
+class TurnCore : public Schedulable
+{
+public:
+    TurnCore(PhaseCore* mainPhase) : _mainPhase(mainPhase)
+    {
+        _mainPhase->setOnCompleteCallback([this]() {
+            wake();
+        });
+    }
+    virtual ~TurnCore() {}
+
+    virtual void startTurn()
+    {
+        _isStarted = true;
+        _mainPhase->startPhase();
+    }
+    bool isDone() const { return _isDone; }
+    void tick() override
+    {
+        if (_isDone || !_mainPhase->isDone())
+            return;
+        _isDone = true;
+        if (_onCompleteCallback)
+            _onCompleteCallback();
+    }
+
+    void setOnCompleteCallback(std::function<void()> callback) { _onCompleteCallback = callback; }
+
+protected:
+    bool _isStarted = false;
+    bool _isDone    = false;
+    PhaseCore* _mainPhase;
+    std::function<void()> _onCompleteCallback = nullptr;
+};
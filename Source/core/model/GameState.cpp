@@ -1 +1,22 @@
 #include "GameState.h"
+
+void GameState::addCard(Card* card)
+{
+    if (cardStore.contains(card->getId()))
+        return;
+    cards.pushBack(card);
+    cardStore.add(card->getId(), card->getFaceUp());
+    _cardBySlot.push_back(card);
+}
+
+void GameState::addZone(Zone* zone)
+{
+    zone->setZoneId(int(zones.size()));
+    zones.pushBack(zone);
+}
+
+Card* GameState::getCard(int cardId) const
+{
+    auto slot = cardStore.indexOf(cardId);
+    return slot == -1 ? nullptr : _cardBySlot[slot];
+}
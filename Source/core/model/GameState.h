@@ -6,6 +6,11 @@
 #include "core/object/Zone.h"
 
 #include "core/view/Player.h"
+#include "core/logic/CommandHistory.h"
+#include "core/logic/GameRandom.h"
+#include "core/logic/ReplayLog.h"
+#include "core/logic/TableState.h"
+#include "core/object/data/CardStore.h"
 
 #include <map>
 #include <vector>
@@ -20,6 +25,14 @@ public:
     // global
     ax::Vector<Card*> cards;
     ax::Vector<Zone*> zones;
+    // Where every card is as plain arrays, kept up to date by the Card and Zone nodes. Query it
+    // rather than walking the nodes.
+    CardStore cardStore;
+
+    // Register a node in cards or zones and the card store, a card needs its id set first
+    void addCard(Card* card);
+    void addZone(Zone* zone);
+    Card* getCard(int cardId) const;  // nullptr for an unknown id
 
     int playerCount = 0;
     int currentPlayerIndex = 0;
@@ -27,9 +40,22 @@ public:
 
     std::string roomId = "";
 
+    // Every shuffle and random choice draws from here, seeded once per game with the server's seed
+    GameRandom random;
+    // Commands record what they executed here while a game is being logged, see GameScene::setUpRule
+    ReplayWriter* replayLog = nullptr;
+    // The table as the server last described it, only ever changed by applying its state deltas
+    TableState table;
+    // The table as this client plays it, moves land here before the server confirms them. Set up from
+    // the deal by MainGameCommand, every move after goes through history so a refused one can be reverted.
+    TableState playTable;
+    CommandHistory history{playTable};
+
     GameScene* gameScene = nullptr;
 
     // local
     Player* clientPlayer = nullptr;
 
+private:
+    std::vector<Card*> _cardBySlot;  // Parallel to the card store's slots
 };
@@ -1,4 +1,5 @@
 #include "HttpRequestHandler.h"
+#include "protocol/BodyParser.h"
 
 string HttpRequestHandler::_url = "http://localhost:5284";
 bool HttpRequestHandler::_isJsonRequest = false;
@@ -34,33 +35,25 @@ void HttpRequestHandler::sendPostRequest(std::string path, std::string body,
     request->release();  // send() retains internally
 }
 
-vector<int> HttpRequestHandler::convertBufferToVectorOfInt(yasio::sbyte_buffer* buffer)
+std::string_view HttpRequestHandler::viewBuffer(const yasio::sbyte_buffer* buffer)
+{
+    if (!buffer)
+        return {};
+    return std::string_view(buffer->data(), buffer->size());
+}
+
+bool HttpRequestHandler::parseIntArray(const yasio::sbyte_buffer* buffer, vector<int>& values)
 {
-    string str = convertBufferToString(buffer);
     // List format: [0,1,2,...,n]
-    vector<int> result;
-    size_t start = 1;  // Skip the opening bracket
-    size_t end = str.find(',', start);
-    while (end != string::npos)
-    {
-        result.push_back(stoi(str.substr(start, end - start)));
-        start = end + 1;
-        end = str.find(',', start);
-    }
-    // Add the last element
-    result.push_back(stoi(str.substr(start, str.length() - start - 1)));
-    return result;
+    return body::parseIntArray(viewBuffer(buffer), values);
 }
 
 string HttpRequestHandler::convertBufferToString(yasio::sbyte_buffer* buffer)
 {
-    string str(buffer->data(), buffer->size());
-    return str;
+    return string(viewBuffer(buffer));
 }
 
-int HttpRequestHandler::convertBufferToInt(yasio::sbyte_buffer* buffer)
+bool HttpRequestHandler::parseInt(const yasio::sbyte_buffer* buffer, int& value)
 {
-    string str = convertBufferToString(buffer);
-    return stoi(str);
+    return body::parseInt(viewBuffer(buffer), value);
 }
-
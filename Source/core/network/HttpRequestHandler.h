@@ -4,6 +4,7 @@
 #include "network/HttpClient.h"
 
 #include <string>
+#include <string_view>
 #include <map>
 
 using namespace std;
@@ -17,11 +18,14 @@ public:
     static void sendGetRequest(std::string path, function<void(HttpClient* client, HttpResponse* response)> callback);
     static void sendPostRequest(std::string path, std::string body, function<void(HttpClient* client, HttpResponse* response)> callback);
 	
-	static vector<int> convertBufferToVectorOfInt(yasio::sbyte_buffer* buffer);
+    // Parse the response bytes in place, false on a malformed body
+    static std::string_view viewBuffer(const yasio::sbyte_buffer* buffer);
+    static bool parseInt(const yasio::sbyte_buffer* buffer, int& value);
+    static bool parseIntArray(const yasio::sbyte_buffer* buffer, vector<int>& values);
 	static string convertBufferToString(yasio::sbyte_buffer* buffer);
-	static int convertBufferToInt(yasio::sbyte_buffer* buffer);
 
     static void setUrl(std::string url) { _url = url; }
+    static const std::string& getUrl() { return _url; }
     static void setJsonRequest(bool isJsonRequest) { _isJsonRequest = isJsonRequest; }
 
 private:
@@ -0,0 +1,60 @@
+#include "MessageRouter.h"
+
+#include <algorithm>
+
+MessageRouter* MessageRouter::_instance = nullptr;
+
+void MessageRouter::on(SocketCommand command, const void* owner, Handler handler)
+{
+    if (_routingDepth > 0)
+        _added.push_back({command, {owner, std::move(handler)}});
+    else
+        _handlers[size_t(command)].push_back({owner, std::move(handler)});
+}
+
+void MessageRouter::removeOwner(const void* owner)
+{
+    for (auto& entries : _handlers)
+    {
+        for (auto& entry : entries)
+        {
+            if (entry.owner == owner)
+            {
+                entry.owner  = nullptr;
+                _hasRemovals = true;
+            }
+        }
+    }
+    std::erase_if(_added, [owner](const auto& added) { return added.second.owner == owner; });
+    if (_routingDepth == 0)
+        flushChanges();
+}
+
+bool MessageRouter::route(const SocketMessage& message)
+{
+    bool handled = false;
+    ++_routingDepth;
+    for (auto& entry : _handlers[size_t(message.getCommand())])
+    {
+        if (entry.owner == nullptr)
+            continue;
+        entry.handler(message);
+        handled = true;
+    }
+    if (--_routingDepth == 0)
+        flushChanges();
+    return handled;
+}
+
+void MessageRouter::flushChanges()
+{
+    if (_hasRemovals)
+    {
+        for (auto& entries : _handlers)
+            std::erase_if(entries, [](const Entry& entry) { return entry.owner == nullptr; });
+        _hasRemovals = false;
+    }
+    for (auto& [command, entry] : _added)
+        _handlers[size_t(command)].push_back(std::move(entry));
+    _added.clear();
+}
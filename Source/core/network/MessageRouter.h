@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core/network/SocketCommand.h"
+#include "core/network/SocketMessage.h"
+
+#include <array>
+#include <functional>
+#include <vector>
+
+// Hands each socket message to the handlers registered for its command and no one else, a table
+// lookup by SocketCommand id. Handlers belong to an owner and must be removed with removeOwner
+// before it is destroyed, the way RequestScheduler::cancelOwner is used. Main thread only.
+class MessageRouter
+{
+public:
+    using Handler = std::function<void(const SocketMessage& message)>;
+
+    static MessageRouter* getInstance()
+    {
+        if (_instance == nullptr)
+        {
+            _instance = new MessageRouter();
+        }
+        return _instance;
+    }
+
+    // Handlers for one command run in the order they were added. Both are safe from inside a
+    // handler: a handler added while routing first sees the next message.
+    void on(SocketCommand command, const void* owner, Handler handler);
+    void removeOwner(const void* owner);
+
+    // False when no handler took the message
+    bool route(const SocketMessage& message);
+
+private:
+    struct Entry
+    {
+        const void* owner;  // Null once removed
+        Handler handler;
+    };
+
+    MessageRouter() = default;
+
+    // Applies the changes held back while routing
+    void flushChanges();
+
+    std::array<std::vector<Entry>, size_t(SocketCommand::COUNT)> _handlers;
+    std::vector<std::pair<SocketCommand, Entry>> _added;  // Added while routing
+    int _routingDepth = 0;
+    bool _hasRemovals = false;  // Removed entries wait with a null owner until no route is running
+
+    static MessageRouter* _instance;
+};
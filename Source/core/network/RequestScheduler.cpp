@@ -0,0 +1,272 @@
+#include "RequestScheduler.h"
+#include "HttpRequestHandler.h"
+
+#include "utils/json.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+using namespace ax::network;
+using json = lib::json;
+
+RequestScheduler* RequestScheduler::_instance = nullptr;
+
+unsigned int RequestScheduler::get(const std::string& path, Callback callback, const Options& options)
+{
+    // Join a GET that is already on its way instead of asking again
+    auto shared = _getCalls.find(path);
+    if (shared != _getCalls.end())
+    {
+        auto requestId = _nextId++;
+        _calls[shared->second].waiters.push_back({requestId, std::move(callback), options.owner});
+        _requestCalls[requestId] = shared->second;
+        return requestId;
+    }
+    return enqueue(HttpRequest::Type::GET, path, "", std::move(callback), options);
+}
+
+unsigned int RequestScheduler::post(const std::string& path, std::string body, Callback callback,
+                                    const Options& options)
+{
+    return enqueue(HttpRequest::Type::POST, path, std::move(body), std::move(callback), options);
+}
+
+unsigned int RequestScheduler::enqueue(HttpRequest::Type type, const std::string& path, std::string body,
+                                       Callback callback, const Options& options)
+{
+    auto callId    = _nextId++;
+    auto requestId = _nextId++;
+    auto& call     = _calls[callId];
+    call.type      = type;
+    call.path      = path;
+    call.body      = std::move(body);
+    call.options   = options;
+    call.waiters.push_back({requestId, std::move(callback), options.owner});
+    _requestCalls[requestId] = callId;
+    if (type == HttpRequest::Type::GET)
+        _getCalls[path] = callId;
+
+    if (options.batchable)
+    {
+        // Everything batchable issued this frame leaves together at the start of the next one
+        if (_batchQueue.empty())
+        {
+            ax::Director::getInstance()->getScheduler()->schedule([this](float) { sendBatch(); }, this, 0.f, 0, 0.f,
+                                                                  false, "request_batch");
+        }
+        _batchQueue.push_back(callId);
+    }
+    else
+    {
+        send(callId);
+    }
+    return requestId;
+}
+
+void RequestScheduler::send(unsigned int callId)
+{
+    auto& call  = _calls[callId];
+    auto token  = ++call.token;
+    auto request = new HttpRequest();
+    request->setRequestType(call.type);
+    request->setUrl(makeUrl(call.path));
+    if (!call.body.empty())
+    {
+        request->setRequestData(call.body.c_str(), call.body.length());
+    }
+    request->setResponseCallback([this, callId, token](HttpClient* client, HttpResponse* response) {
+        auto data = response->getResponseData();
+        Response answer;
+        answer.code = static_cast<int>(response->getResponseCode());
+        answer.body = HttpRequestHandler::viewBuffer(data);
+        onAnswer(callId, token, answer);
+    });
+    HttpClient::getInstance()->send(request);
+    request->release();  // send() retains internally
+    scheduleTimeout(callId);
+}
+
+void RequestScheduler::sendBatch()
+{
+    auto queue = std::move(_batchQueue);
+    _batchQueue.clear();
+    queue.erase(std::remove_if(queue.begin(), queue.end(), [this](unsigned int id) { return !_calls.count(id); }),
+                queue.end());
+    if (queue.size() == 1)
+    {
+        send(queue.front());
+        return;
+    }
+    if (queue.empty())
+        return;
+
+    // Each call keeps its own token and timeout, so a slow batch times out and retries per request
+    std::vector<std::pair<unsigned int, unsigned int>> attempts;
+    json body = json::array();
+    for (auto callId : queue)
+    {
+        auto& call = _calls[callId];
+        attempts.emplace_back(callId, ++call.token);
+        scheduleTimeout(callId);
+        body.push_back({{"method", call.type == HttpRequest::Type::GET ? "GET" : "POST"},
+                        {"path", call.path},
+                        {"body", call.body}});
+    }
+
+    auto request = new HttpRequest();
+    request->setRequestType(HttpRequest::Type::POST);
+    request->setUrl(makeUrl("/batch"));
+    request->setHeaders({"Content-Type: application/json;charset=UTF-8"});
+    auto payload = body.dump();
+    request->setRequestData(payload.c_str(), payload.length());
+    request->setResponseCallback([this, attempts](HttpClient* client, HttpResponse* response) {
+        json answers;
+        if (response->getResponseCode() == 200)
+        {
+            auto text = HttpRequestHandler::viewBuffer(response->getResponseData());
+            answers   = json::parse(text.begin(), text.end(), nullptr, false);
+        }
+        if (!answers.is_array() || answers.size() != attempts.size())
+        {
+            // The batch as a whole failed, give every request still waiting its own attempt
+            for (auto [callId, token] : attempts)
+            {
+                auto it = _calls.find(callId);
+                if (it != _calls.end() && it->second.token == token)
+                    send(callId);
+            }
+            return;
+        }
+        for (size_t i = 0; i < attempts.size(); ++i)
+        {
+            auto text = answers[i].value("body", std::string());
+            Response answer;
+            answer.code = answers[i].value("status", 0);
+            answer.body = text;
+            onAnswer(attempts[i].first, attempts[i].second, answer);
+        }
+    });
+    HttpClient::getInstance()->send(request);
+    request->release();
+}
+
+void RequestScheduler::onAnswer(unsigned int callId, unsigned int token, const Response& response)
+{
+    auto it = _calls.find(callId);
+    if (it == _calls.end() || it->second.token != token)
+        return;  // Cancelled, timed out or superseded by a retry
+    auto& call = it->second;
+    ax::Director::getInstance()->getScheduler()->unschedule(timerKey("request_timeout_", callId), this);
+
+    bool retryable = response.timedOut || response.code <= 0 || response.code >= 500;
+    if (retryable && call.attempt < call.options.retries)
+    {
+        float delay = call.options.retryDelay * std::pow(2.f, float(call.attempt));
+        ++call.attempt;
+        ++call.token;  // Ignore the old attempt even if it answers late
+        AXLOGD("Retrying {} in {}s, attempt {}", call.path, delay, call.attempt);
+        ax::Director::getInstance()->getScheduler()->schedule([this, callId](float) { send(callId); }, this, 0.f, 0,
+                                                              delay, false, timerKey("request_retry_", callId));
+        return;
+    }
+    finish(callId, response);
+}
+
+void RequestScheduler::finish(unsigned int callId, const Response& response)
+{
+    auto it = _calls.find(callId);
+    if (it == _calls.end())
+        return;
+    // Take the call out before running callbacks, they may issue the same GET again
+    auto waiters = std::move(it->second.waiters);
+    dropCall(callId);
+    for (auto& waiter : waiters)
+    {
+        _requestCalls.erase(waiter.requestId);
+        if (waiter.callback)
+            waiter.callback(response);
+    }
+}
+
+void RequestScheduler::scheduleTimeout(unsigned int callId)
+{
+    auto& call     = _calls[callId];
+    auto token     = call.token;
+    auto scheduler = ax::Director::getInstance()->getScheduler();
+    // Scheduling an existing key keeps the old callback, drop it first
+    scheduler->unschedule(timerKey("request_timeout_", callId), this);
+    scheduler->schedule(
+        [this, callId, token](float) {
+        Response response;
+        response.timedOut = true;
+        onAnswer(callId, token, response);
+    }, this, 0.f, 0, call.options.timeout, false, timerKey("request_timeout_", callId));
+}
+
+void RequestScheduler::cancel(unsigned int requestId)
+{
+    auto found = _requestCalls.find(requestId);
+    if (found == _requestCalls.end())
+        return;
+    auto callId = found->second;
+    _requestCalls.erase(found);
+
+    auto& waiters = _calls[callId].waiters;
+    waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                 [requestId](const Waiter& waiter) { return waiter.requestId == requestId; }),
+                  waiters.end());
+    if (waiters.empty())
+        dropCall(callId);  // Nobody is waiting, a late answer finds no call and is ignored
+}
+
+void RequestScheduler::cancelOwner(const void* owner)
+{
+    if (!owner)
+        return;
+    std::vector<unsigned int> requestIds;
+    for (auto& [callId, call] : _calls)
+        for (auto& waiter : call.waiters)
+            if (waiter.owner == owner)
+                requestIds.push_back(waiter.requestId);
+    for (auto requestId : requestIds)
+        cancel(requestId);
+}
+
+void RequestScheduler::dropCall(unsigned int callId)
+{
+    auto it = _calls.find(callId);
+    if (it == _calls.end())
+        return;
+    auto shared = _getCalls.find(it->second.path);
+    if (shared != _getCalls.end() && shared->second == callId)
+        _getCalls.erase(shared);
+    auto scheduler = ax::Director::getInstance()->getScheduler();
+    scheduler->unschedule(timerKey("request_timeout_", callId), this);
+    scheduler->unschedule(timerKey("request_retry_", callId), this);
+    _calls.erase(it);
+}
+
+std::string RequestScheduler::makeUrl(const std::string& path) const
+{
+    auto url = HttpRequestHandler::getUrl() + path;
+    if (_roomId.empty())
+        return url;
+
+    // Room ids are typed in by players, escape everything outside the unreserved set
+    static const char* HEX = "0123456789ABCDEF";
+    url += path.find('?') == std::string::npos ? "?room=" : "&room=";
+    for (unsigned char c : _roomId)
+    {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~')
+            url += char(c);
+        else
+            url += {'%', HEX[c >> 4], HEX[c & 15]};
+    }
+    return url;
+}
+
+std::string RequestScheduler::timerKey(const char* prefix, unsigned int callId)
+{
+    return prefix + std::to_string(callId);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "axmol.h"
+#include "network/HttpClient.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Game requests on top of HttpClient:
+// - identical GETs already in flight share one network call
+// - batchable requests issued in the same frame go out as one POST /batch
+// - per-request timeout, retry with exponential backoff on network/server errors
+// - cancellation by owner, so callbacks never reach a destroyed Command
+// The savings come from sending fewer requests. Connections are left to HttpClient, nothing here
+// keeps them open between requests.
+class RequestScheduler
+{
+public:
+    struct Response
+    {
+        int code = 0;           // HTTP status, 0 when the request never got an answer
+        std::string_view body;  // Only valid inside the callback
+        bool timedOut = false;
+
+        bool succeeded() const { return code >= 200 && code < 300; }
+    };
+    using Callback = std::function<void(const Response& response)>;
+
+    struct Options
+    {
+        float timeout    = 10.f;   // Seconds per attempt
+        int retries      = 0;      // Extra attempts after a timeout, network error or 5xx
+        float retryDelay = 0.5f;   // Doubles after every attempt
+        const void* owner = nullptr;  // cancelOwner(owner) drops every request it issued
+        bool batchable   = false;  // May share a /batch round trip with requests from the same frame
+    };
+
+    static RequestScheduler* getInstance()
+    {
+        if (_instance == nullptr)
+        {
+            _instance = new RequestScheduler();
+        }
+        return _instance;
+    }
+
+    unsigned int get(const std::string& path, Callback callback, const Options& options = Options());
+    unsigned int post(const std::string& path, std::string body, Callback callback, const Options& options = Options());
+
+    void cancel(unsigned int requestId);
+    void cancelOwner(const void* owner);
+
+    // Every request carries ?room= so the server plays it in the room the socket created or joined
+    void setRoomId(const std::string& roomId) { _roomId = roomId; }
+    const std::string& getRoomId() const { return _roomId; }
+
+private:
+    struct Waiter
+    {
+        unsigned int requestId;
+        Callback callback;
+        const void* owner;
+    };
+
+    // One network exchange, shared by every coalesced GET waiting on it
+    struct Call
+    {
+        ax::network::HttpRequest::Type type;
+        std::string path;
+        std::string body;
+        Options options;
+        std::vector<Waiter> waiters;
+        int attempt       = 0;
+        unsigned int token = 0;  // Changes on every attempt, late answers to an old attempt are ignored
+    };
+
+    RequestScheduler() = default;
+
+    unsigned int enqueue(ax::network::HttpRequest::Type type, const std::string& path, std::string body,
+                         Callback callback, const Options& options);
+    void send(unsigned int callId);
+    void sendBatch();
+    void onAnswer(unsigned int callId, unsigned int token, const Response& response);
+    void finish(unsigned int callId, const Response& response);
+    void scheduleTimeout(unsigned int callId);
+    void dropCall(unsigned int callId);
+    static std::string timerKey(const char* prefix, unsigned int callId);
+    std::string makeUrl(const std::string& path) const;
+
+    unsigned int _nextId = 1;
+    std::unordered_map<unsigned int, Call> _calls;
+    std::unordered_map<std::string, unsigned int> _getCalls;      // Path of an in-flight GET -> its call
+    std::unordered_map<unsigned int, unsigned int> _requestCalls;  // Request id -> call
+    std::vector<unsigned int> _batchQueue;
+    std::string _roomId;  // Empty for the server's shared demo room
+
+    static RequestScheduler* _instance;
+};
@@ -0,0 +1,21 @@
+#include "SocketCommand.h"
+
+#include <unordered_map>
+
+SocketCommand toSocketCommand(std::string_view name)
+{
+    static const std::unordered_map<std::string_view, SocketCommand> commands = {
+        {"resume", SocketCommand::RESUME},
+        {"create_room", SocketCommand::CREATE_ROOM},
+        {"join_room", SocketCommand::JOIN_ROOM},
+        {"leave_room", SocketCommand::LEAVE_ROOM},
+        {"list_rooms", SocketCommand::LIST_ROOMS},
+        {"list_users_in_room", SocketCommand::LIST_USERS_IN_ROOM},
+        {"user_joined", SocketCommand::USER_JOINED},
+        {"user_left", SocketCommand::USER_LEFT},
+        {"broadcast", SocketCommand::BROADCAST},
+        {"card_played", SocketCommand::CARD_PLAYED},
+    };
+    auto it = commands.find(name);
+    return it == commands.end() ? SocketCommand::UNKNOWN : it->second;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Every message the game socket can deliver, as a small id for MessageRouter's table. Text
+// messages map from their "command" string once on the parser thread, binary frames from their
+// wire::MessageType.
+enum class SocketCommand : uint8_t
+{
+    UNKNOWN,
+    RESUME,
+    CREATE_ROOM,
+    JOIN_ROOM,
+    LEAVE_ROOM,
+    LIST_ROOMS,
+    LIST_USERS_IN_ROOM,
+    USER_JOINED,
+    USER_LEFT,
+    BROADCAST,
+    CARD_PLAYED,
+    MOVE,  // Binary
+    COUNT
+};
+
+// UNKNOWN for names the client does not handle
+SocketCommand toSocketCommand(std::string_view name);
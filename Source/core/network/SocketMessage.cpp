@@ -0,0 +1,28 @@
+#include "SocketMessage.h"
+
+SocketMessagePtr SocketMessage::parseText(std::string_view text)
+{
+    auto data = lib::json::parse(text.begin(), text.end(), nullptr, false);
+    if (!data.is_object())
+        return nullptr;
+
+    std::shared_ptr<SocketMessage> message(new SocketMessage());
+    if (data.contains("seq") && data["seq"].is_number_unsigned())
+        message->_seq = data["seq"].get<uint64_t>();
+    if (data.contains("command") && data["command"].is_string())
+        message->_command = toSocketCommand(data["command"].get_ref<const std::string&>());
+    message->_data = std::move(data);
+    return message;
+}
+
+SocketMessagePtr SocketMessage::parseBinary(std::vector<uint8_t> frame)
+{
+    std::shared_ptr<SocketMessage> message(new SocketMessage());
+    message->_isBinary = true;
+    message->_frame    = std::move(frame);
+    if (!wire::decodeFrame(message->_frame, message->_header, message->_payload))
+        return nullptr;
+    if (message->_header.type == wire::MessageType::MOVE)
+        message->_command = SocketCommand::MOVE;
+    return message;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "utils/json.hpp"
+#include "core/network/SocketCommand.h"
+#include "core/network/protocol/WireProtocol.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class SocketMessage;
+using SocketMessagePtr = std::shared_ptr<const SocketMessage>;
+
+// One frame from the game socket, parsed on SocketNetworkManager's parser thread and never changed
+// afterwards, so every listener reads the same object without copies or locks. Keep the pointer to
+// hold on to a message past its dispatch.
+class SocketMessage
+{
+public:
+    // Null when the text is not a JSON object or the frame is not a valid wire frame
+    static SocketMessagePtr parseText(std::string_view text);
+    static SocketMessagePtr parseBinary(std::vector<uint8_t> frame);
+
+    bool isBinary() const { return _isBinary; }
+    SocketCommand getCommand() const { return _command; }
+
+    // Text frames
+    const lib::json& getData() const { return _data; }
+    uint64_t getSeq() const { return _seq; }  // The server's sequence number, 0 when unsequenced
+
+    // Binary frames, the payload views this message's own bytes
+    const wire::Header& getHeader() const { return _header; }
+    std::span<const uint8_t> getPayload() const { return _payload; }
+
+private:
+    SocketMessage() = default;
+
+    bool _isBinary         = false;
+    SocketCommand _command = SocketCommand::UNKNOWN;
+    lib::json _data;
+    uint64_t _seq = 0;
+    std::vector<uint8_t> _frame;
+    wire::Header _header{};
+    std::span<const uint8_t> _payload;
+};
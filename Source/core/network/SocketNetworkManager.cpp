@@ -1,6 +1,10 @@
 #include "SocketNetworkManager.h"
 #include "utils/json.hpp"
 #include "core/event/EventWebSocket.h"
+#include "core/network/MessageRouter.h"
+
+#include <algorithm>
+#include <chrono>
 
 using json = lib::json;
 
@@ -8,36 +12,153 @@ SocketNetworkManager* SocketNetworkManager::_instance = nullptr;
 
 SocketNetworkManager::SocketNetworkManager()
 {
-    _ws = new WebSocket();
+    _ws     = new WebSocket();
+    _parser = std::thread(&SocketNetworkManager::parseFrames, this);
+    ax::Director::getInstance()->getScheduler()->schedule([this](float) { dispatchMessages(); }, this, 0.f, false,
+                                                          "socket_dispatch");
+}
+
+SocketNetworkManager::~SocketNetworkManager()
+{
+    ax::Director::getInstance()->getScheduler()->unscheduleAllForTarget(this);
+    _isStopping = true;
+    _rawFrameCount.fetch_add(1);
+    _rawFrameCount.notify_one();
+    _parser.join();
+    delete _ws;
 }
 
 void SocketNetworkManager::onOpen(WebSocket* ws)
 {
+    if (ws != _ws)
+        return;
     AXLOGD("WebSocket connection opened.");
-    EventWebSocket* event = new EventWebSocket(EventWebSocket::WebSocketEventType::OPEN);
-    ax::Director::getInstance()->getEventDispatcher()->dispatchEvent(event);
+    _reconnectDelay = 0.f;
+    if (!_isResuming)
+    {
+        // A new session, the server has seen none of what was queued before it opened
+        sendUnwritten();
+    }
+    else
+    {
+        ax::Director::getInstance()->getScheduler()->schedule([this](float) { onResumeUnanswered(); }, this, 0.f, 0,
+                                                              RESUME_TIMEOUT, false, "socket_resume_timeout");
+    }
+    EventWebSocket event(EventWebSocket::WebSocketEventType::OPEN);
+    ax::Director::getInstance()->getEventDispatcher()->dispatchEvent(&event);
 }
 void SocketNetworkManager::onMessage(WebSocket* ws, const WebSocket::Data& data)
 {
-    if (data.isBinary)
+    if (ws != _ws)
+        return;
+    // Only the copy out of the socket's buffer happens here, the parser thread does the rest
+    auto bytes = reinterpret_cast<const uint8_t*>(data.bytes);
+    RawFrame frame{std::vector<uint8_t>(bytes, bytes + data.len), data.isBinary, _connection};
+    if (!flushBacklog() || !pushFrame(frame))
+        _backlog.push_back(std::move(frame));  // Never wait here, the parser may be waiting on us
+}
+
+bool SocketNetworkManager::pushFrame(RawFrame& frame)
+{
+    if (!_rawFrames.push(std::move(frame)))
+        return false;
+    _rawFrameCount.fetch_add(1);
+    _rawFrameCount.notify_one();
+    return true;
+}
+
+bool SocketNetworkManager::flushBacklog()
+{
+    while (!_backlog.empty() && pushFrame(_backlog.front()))
+        _backlog.pop_front();
+    return _backlog.empty();
+}
+
+void SocketNetworkManager::parseFrames()
+{
+    RawFrame frame;
+    while (true)
     {
+        _rawFrameCount.wait(0);
+        if (_isStopping)
+            return;
+        if (_parsed.full())
+        {
+            // Leave the raw frames queued until the main thread makes room, it drains every frame
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (!_rawFrames.pop(frame))
+            continue;
+        _rawFrameCount.fetch_sub(1);
 
+        SocketMessagePtr message;
+        if (frame.isBinary)
+        {
+            message = SocketMessage::parseBinary(std::move(frame.bytes));
+        }
+        else
+        {
+            auto text = std::string_view(reinterpret_cast<const char*>(frame.bytes.data()), frame.bytes.size());
+            AXLOGD("Received message: {}", text);
+            message = SocketMessage::parseText(text);
+        }
+        if (!message)
+        {
+            AXLOGD("Dropped malformed {} message", frame.isBinary ? "binary" : "text");
+            continue;
+        }
+        _parsed.push({message, frame.connection});  // Checked for room above, only this thread pushes
     }
-    else
-    { // JSON
-        std::string message(data.bytes, data.len);
-        AXLOGD("Received message: {}", message);
-        json jsonMessage = json::parse(message);
-        EventWebSocket *event = new EventWebSocket(EventWebSocket::WebSocketEventType::MESSAGE, jsonMessage);
-        ax::Director::getInstance()->getEventDispatcher()->dispatchEvent(event);
+}
+
+void SocketNetworkManager::dispatchMessages()
+{
+    if (_backlog.size() > MAX_BACKLOG_FRAMES)
+    {
+        AXLOGD("{} socket frames behind, reconnecting to resume", _backlog.size());
+        _backlog.clear();
+        reconnect();  // Resumes after the last dispatched seq, what was queued is replayed
+    }
+    flushBacklog();
+
+    ParsedMessage parsed;
+    for (int i = 0; i < MAX_DISPATCH_PER_FRAME && _parsed.pop(parsed); ++i)
+    {
+        if (parsed.connection != _connection)
+            continue;  // Arrived on a socket reconnect has since replaced
+        auto& message = parsed.message;
+        if (_isResuming && message->getCommand() != SocketCommand::RESUME)
+            onResumeUnanswered();  // The resume reply always comes first, this server does not resume
+
+        if (message->getSeq() != 0)
+        {
+            if (message->getSeq() <= _lastReceivedSeq)
+                continue;  // Replayed on resume but already handled
+            _lastReceivedSeq = message->getSeq();
+        }
+        else if (_isResuming && message->getCommand() == SocketCommand::RESUME)
+        {
+            onResumed(message->getData().value("data", json::object()));
+        }
+        if (!MessageRouter::getInstance()->route(*message))
+            AXLOGD("No handler for socket command {}", int(message->getCommand()));
     }
 }
+
 void SocketNetworkManager::onClose(WebSocket* ws, uint16_t code, std::string_view reason)
 {
+    if (ws != _ws)
+        return;  // A connection already replaced by reconnect
     AXLOGD("WebSocket connection closed.");
+    EventWebSocket event(EventWebSocket::WebSocketEventType::CLOSE);
+    ax::Director::getInstance()->getEventDispatcher()->dispatchEvent(&event);
+    scheduleReconnect();
 }
 void SocketNetworkManager::onError(WebSocket* ws, const WebSocket::ErrorCode& error)
 {
+    if (ws != _ws)
+        return;
     switch (error)
     {
     case WebSocket::ErrorCode::TIME_OUT:
@@ -49,13 +170,102 @@ void SocketNetworkManager::onError(WebSocket* ws, const WebSocket::ErrorCode& er
     default:
         AXLOGD("WebSocket error");
     }
+#undef ERROR
+    EventWebSocket event(EventWebSocket::WebSocketEventType::ERROR);
+#define ERROR 0
+    ax::Director::getInstance()->getEventDispatcher()->dispatchEvent(&event);
+    scheduleReconnect();
 }
 
 void SocketNetworkManager::connect(const std::string& url)
 {
+    ax::Director::getInstance()->getScheduler()->unschedule("socket_reconnect", this);
+    ax::Director::getInstance()->getScheduler()->unschedule("socket_resume_timeout", this);
+    ++_connection;
+    _backlog.clear();
+    _url             = url;
+    _lastReceivedSeq = 0;
+    _sent.clear();
+    _lastWrittenId   = _lastSentId;
+    _isResuming      = false;
+    _reconnectDelay  = 0.f;
     _ws->open(this, url);
 }
 
+void SocketNetworkManager::scheduleReconnect()
+{
+    auto scheduler = ax::Director::getInstance()->getScheduler();
+    if (_url.empty() || scheduler->isScheduled("socket_reconnect", this))
+        return;  // Never connected, or onError and onClose both reported the same drop
+
+    AXLOGD("Reconnecting in {}s", _reconnectDelay);
+    scheduler->schedule([this](float) { reconnect(); }, this, 0.f, 0, _reconnectDelay, false, "socket_reconnect");
+    _reconnectDelay = std::clamp(_reconnectDelay * 2.f, MIN_RECONNECT_DELAY, MAX_RECONNECT_DELAY);
+}
+
+void SocketNetworkManager::reconnect()
+{
+    // A closed WebSocket cannot be reopened, replace it. onClose and onError ignore the old one from here on.
+    ax::Director::getInstance()->getScheduler()->unschedule("socket_resume_timeout", this);
+    auto closed = _ws;
+    _ws         = new WebSocket();
+    delete closed;
+    _ws->setHeaders(_headers);
+    ++_connection;
+    _backlog.clear();
+
+    _isResuming = true;
+    auto separator = _url.find('?') == std::string::npos ? '?' : '&';
+    _ws->open(this, _url + separator + "since=" + std::to_string(_lastReceivedSeq));
+}
+
+void SocketNetworkManager::onResumed(const json& data)
+{
+    ax::Director::getInstance()->getScheduler()->unschedule("socket_resume_timeout", this);
+    _isResuming   = false;
+    auto received = data.value("received", uint64_t(0));
+    while (!_sent.empty() && _sent.front().first <= received)
+        _sent.pop_front();
+    if (!_sent.empty() && _sent.front().first > received + 1)
+        AXLOGD("Messages {} to {} fell out of the replay buffer", received + 1, _sent.front().first - 1);
+    _lastWrittenId = std::min(_lastWrittenId, received);
+    sendUnwritten();
+    if (!data.value("complete", true))
+    {
+        AXLOGD("Server messages were lost while disconnected, resyncing");
+        dispatchResync();
+    }
+}
+
+void SocketNetworkManager::onResumeUnanswered()
+{
+    AXLOGD("Server did not resume the session, starting a new one");
+    ax::Director::getInstance()->getScheduler()->unschedule("socket_resume_timeout", this);
+    _isResuming      = false;
+    _lastReceivedSeq = 0;
+    // What reached the old socket may have been handled already, and replaying a create_room or a
+    // play would do it twice. Only what never left the client goes out.
+    sendUnwritten();
+    dispatchResync();
+}
+
+void SocketNetworkManager::sendUnwritten()
+{
+    for (auto& [id, message] : _sent)
+    {
+        if (id <= _lastWrittenId)
+            continue;
+        _ws->send(message);
+        _lastWrittenId = id;
+    }
+}
+
+void SocketNetworkManager::dispatchResync()
+{
+    EventWebSocket event(EventWebSocket::WebSocketEventType::RESYNC);
+    ax::Director::getInstance()->getEventDispatcher()->dispatchEvent(&event);
+}
+
 void SocketNetworkManager::sendMessage(const std::string& message)
 {
     if (_ws && _ws->getReadyState() == WebSocket::State::OPEN)
@@ -65,7 +275,30 @@ void SocketNetworkManager::sendMessage(const std::string& message)
     }
 }
 
+void SocketNetworkManager::sendMessage(json message)
+{
+    message["id"] = ++_lastSentId;
+    _sent.emplace_back(_lastSentId, message.dump());
+    if (_sent.size() > REPLAY_CAPACITY)
+        _sent.pop_front();
+    if (isConnected() && !_isResuming)
+    {
+        AXLOGD("Sending message: {}", _sent.back().second);
+        _ws->send(_sent.back().second);
+        _lastWrittenId = _lastSentId;
+    }
+}
+
+void SocketNetworkManager::sendBinary(const std::vector<uint8_t>& frame)
+{
+    if (_ws && _ws->getReadyState() == WebSocket::State::OPEN)
+    {
+        _ws->send(frame.data(), static_cast<unsigned int>(frame.size()));
+    }
+}
+
 void SocketNetworkManager::setAuthorizationHeader(const std::string& authToken)
 {
-    _ws->setHeaders({"Authorization:" + authToken});
+    _headers = {"Authorization:" + authToken};
+    _ws->setHeaders(_headers);
 }
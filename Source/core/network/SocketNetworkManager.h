@@ -3,16 +3,38 @@
 #include "axmol.h"
 #include "network/WebSocket.h"
 #include "core/event/EventListenerWebSocket.h"
+#include "core/network/SocketMessage.h"
+#include "core/network/SpscQueue.h"
 
 #include "utils/json.hpp"
 
 #include <string>
 #include <map>
+#include <deque>
+#include <atomic>
+#include <thread>
 
 using namespace std;
 using namespace ax;
 using namespace ax::network;
 
+// The one game socket. It reconnects on its own with exponential backoff and resumes where it
+// left off: JSON messages go out with increasing "id"s and the latest REPLAY_CAPACITY are kept,
+// the server stamps its own with "seq". Reconnecting asks for everything after the last seq seen
+// and resends what the server reports it never received, so nothing is lost or handled twice.
+// A server that does not answer the resume within RESUME_TIMEOUT, or answers with anything else
+// first, keeps no session: it gets what was never written to a socket, and listeners get RESYNC to
+// rebuild what they missed, as they do when the server reports lost messages.
+//
+// Incoming frames are parsed on a thread of their own. The main thread only copies each frame into
+// a lock-free queue and, once per frame, routes up to MAX_DISPATCH_PER_FRAME parsed messages through
+// MessageRouter, so JSON parsing never costs render time and a burst of broadcasts is spread over a
+// few frames. Connection changes are still EventWebSocket events.
+//
+// Neither thread waits on the other's queue while holding work the other needs. The parser stops
+// taking raw frames while the parsed queue is full; the main thread never blocks, frames that do
+// not fit wait in a main-side backlog. Past MAX_BACKLOG_FRAMES the client is hopelessly behind:
+// the backlog is dropped and the socket reconnects, resuming after the last message dispatched.
 class SocketNetworkManager : public WebSocket::Delegate
 {
 
@@ -31,15 +53,74 @@ public:
     void onClose(WebSocket* ws, uint16_t code, std::string_view reason) override;
     void onError(WebSocket* ws, const WebSocket::ErrorCode& error) override;
 
+    // Starts a new session, the server's numbering starts over
     void connect(const std::string& url);
+    bool isConnected() const { return _ws && _ws->getReadyState() == WebSocket::State::OPEN; }
+    // Unsequenced, dropped while disconnected
     void sendMessage(const std::string& message);
-    void sendMessage(const lib::json& message) { sendMessage(message.dump()); }
+    // Stamped with the next id and kept for resending, sent once connected again if the socket is down
+    void sendMessage(lib::json message);
+    void sendBinary(const std::vector<uint8_t>& frame);  // One or more wire::encode* messages
 
     void setAuthorizationHeader(const std::string& authToken);
 
 private:
+    static constexpr size_t REPLAY_CAPACITY     = 64;
+    static constexpr float MIN_RECONNECT_DELAY  = 0.5f;
+    static constexpr float MAX_RECONNECT_DELAY  = 30.f;
+    static constexpr float RESUME_TIMEOUT       = 3.f;
+    static constexpr size_t QUEUE_CAPACITY      = 1024;
+    static constexpr int MAX_DISPATCH_PER_FRAME = 32;
+    static constexpr size_t MAX_BACKLOG_FRAMES  = 8192;
+
+    struct RawFrame
+    {
+        std::vector<uint8_t> bytes;
+        bool isBinary       = false;
+        uint32_t connection = 0;
+    };
+
+    struct ParsedMessage
+    {
+        SocketMessagePtr message;
+        uint32_t connection = 0;  // Messages of a replaced socket are dropped
+    };
+
     SocketNetworkManager();
+    ~SocketNetworkManager();
+
+    void parseFrames();  // Parser thread
+    void dispatchMessages();
+    bool pushFrame(RawFrame& frame);  // False when the parser's queue is full
+    bool flushBacklog();              // False when frames are still waiting
+
+    void scheduleReconnect();
+    void reconnect();
+    // The server's answer to a resume: drop what it received, resend the rest in order
+    void onResumed(const lib::json& data);
+    // The server kept nothing of the session, carry on as a new one
+    void onResumeUnanswered();
+    void sendUnwritten();  // Everything queued after _lastWrittenId, in order
+    void dispatchResync();
 
     WebSocket* _ws;
+    std::string _url;
+    std::vector<std::string> _headers;
+
+    uint64_t _lastSentId      = 0;
+    uint64_t _lastWrittenId   = 0;  // Newest id handed to a socket
+    uint64_t _lastReceivedSeq = 0;
+    std::deque<std::pair<uint64_t, std::string>> _sent;  // Oldest first
+    bool _isResuming          = false;
+    float _reconnectDelay     = 0.f;  // The first retry goes straight away, e.g. after switching networks
+    uint32_t _connection      = 0;    // Bumped for each socket, only touched on the main thread
+
+    SpscQueue<RawFrame, QUEUE_CAPACITY> _rawFrames;       // Main thread to parser
+    SpscQueue<ParsedMessage, QUEUE_CAPACITY> _parsed;     // Parser to main thread, in arrival order
+    std::deque<RawFrame> _backlog;                        // Main thread only, frames the parser had no room for
+    std::atomic<uint32_t> _rawFrameCount{0};              // The parser sleeps on this while it is 0
+    std::atomic<bool> _isStopping{false};
+    std::thread _parser;
+
     static SocketNetworkManager* _instance;
 };
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer single-consumer ring. One thread pushes and one other thread pops, neither
+// takes a lock: push fails when the ring is full and pop when it is empty.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer thread only, value is left as it was when the ring is full
+    bool push(T&& value)
+    {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        _slots[tail & (Capacity - 1)] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only, the slot is left moved-from
+    bool pop(T& value)
+    {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        value = std::move(_slots[head & (Capacity - 1)]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+    // Exact on the producer thread, the consumer can only make room
+    bool full() const
+    {
+        return _tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_acquire) == Capacity;
+    }
+
+private:
+    std::array<T, Capacity> _slots{};
+    alignas(64) std::atomic<size_t> _head{0};  // Written by the consumer only
+    alignas(64) std::atomic<size_t> _tail{0};  // Written by the producer only
+};
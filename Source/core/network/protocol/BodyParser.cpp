@@ -0,0 +1,95 @@
+#include "BodyParser.h"
+
+#include <charconv>
+
+namespace body
+{
+namespace
+{
+bool isSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+void skipSpace(const char*& it, const char* end)
+{
+    while (it != end && isSpace(*it))
+        ++it;
+}
+
+template <typename T>
+bool readInt(const char*& it, const char* end, T& value)
+{
+    auto result = std::from_chars(it, end, value);
+    if (result.ec != std::errc())
+        return false;
+    it = result.ptr;
+    return true;
+}
+}  // namespace
+
+bool parseInt(std::string_view text, int& value)
+{
+    const char* it  = text.data();
+    const char* end = it + text.size();
+    skipSpace(it, end);
+    if (!readInt(it, end, value))
+        return false;
+    skipSpace(it, end);
+    return it == end;
+}
+
+bool parseUInt64(std::string_view text, uint64_t& value)
+{
+    const char* it  = text.data();
+    const char* end = it + text.size();
+    skipSpace(it, end);
+    if (!readInt(it, end, value))
+        return false;
+    skipSpace(it, end);
+    return it == end;
+}
+
+bool parseIntArray(std::string_view text, std::vector<int>& values)
+{
+    values.clear();
+    const char* it  = text.data();
+    const char* end = it + text.size();
+
+    skipSpace(it, end);
+    if (it == end || *it++ != '[')
+        return false;
+    skipSpace(it, end);
+    if (it != end && *it == ']')
+    {
+        ++it;
+        skipSpace(it, end);
+        return it == end;
+    }
+
+    // Commas bound the element count, so one reserve covers the whole array
+    size_t commas = 0;
+    for (auto ch = it; ch != end; ++ch)
+        commas += *ch == ',';
+    values.reserve(commas + 1);
+
+    while (true)
+    {
+        int value;
+        skipSpace(it, end);
+        if (!readInt(it, end, value))
+            return false;
+        values.push_back(value);
+        skipSpace(it, end);
+        if (it == end)
+            return false;
+        char separator = *it++;
+        if (separator == ']')
+            break;
+        if (separator != ',')
+            return false;
+    }
+    skipSpace(it, end);
+    return it == end;
+}
+}  // namespace body
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Parsers for the small plain-text bodies the game server returns, working directly on the response
+// bytes. Malformed input returns false instead of throwing.
+namespace body
+{
+// A single integer, surrounding whitespace allowed: "42"
+bool parseInt(std::string_view text, int& value);
+// A game seed, the full unsigned 64-bit range: "18446744073709551615"
+bool parseUInt64(std::string_view text, uint64_t& value);
+
+// A JSON array of integers: "[3, 0, 2, 1]". Clears values first and reuses its capacity.
+bool parseIntArray(std::string_view text, std::vector<int>& values);
+}  // namespace body
@@ -0,0 +1,208 @@
+#include "WireProtocol.h"
+
+namespace wire
+{
+namespace
+{
+uint64_t zigzag(int64_t value)
+{
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value)
+{
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+// Each list element takes at least one byte, so a count larger than the payload is malformed
+bool readCount(Reader& reader, uint32_t& count, size_t bytesPerEntry)
+{
+    uint64_t value;
+    if (!reader.readVarint(value) || value > reader.remaining() / bytesPerEntry)
+        return false;
+    count = uint32_t(value);
+    return true;
+}
+}  // namespace
+
+bool Reader::readVarint(uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (_data == _end)
+            return false;
+        uint8_t byte = *_data++;
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;  // More than 10 bytes
+}
+
+bool Reader::readSigned(int64_t& value)
+{
+    uint64_t raw;
+    if (!readVarint(raw))
+        return false;
+    value = unzigzag(raw);
+    return true;
+}
+
+Writer::Writer(std::vector<uint8_t>& out, MessageType type) : _out(out), _start(out.size())
+{
+    _out.push_back(VERSION);
+    _out.push_back(uint8_t(type));
+    _out.push_back(0);
+    _out.push_back(0);
+}
+
+void Writer::writeVarint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        _out.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    _out.push_back(uint8_t(value));
+}
+
+void Writer::writeSigned(int64_t value)
+{
+    writeVarint(zigzag(value));
+}
+
+bool Writer::finish()
+{
+    size_t payloadSize = _out.size() - _start - HEADER_SIZE;
+    if (payloadSize > MAX_PAYLOAD)
+        return false;
+    _out[_start + 2] = uint8_t(payloadSize);
+    _out[_start + 3] = uint8_t(payloadSize >> 8);
+    return true;
+}
+
+bool decodeFrame(std::span<const uint8_t> frame, Header& header, std::span<const uint8_t>& payload)
+{
+    if (frame.size() < HEADER_SIZE)
+        return false;
+    header.version     = frame[0];
+    header.type        = MessageType(frame[1]);
+    header.payloadSize = uint16_t(frame[2] | (frame[3] << 8));
+    if (header.version != VERSION || frame.size() < HEADER_SIZE + header.payloadSize)
+        return false;
+    payload = frame.subspan(HEADER_SIZE, header.payloadSize);
+    return true;
+}
+
+void encodeMove(std::vector<uint8_t>& out, const MoveMessage& message)
+{
+    Writer writer(out, MessageType::MOVE);
+    writer.writeSigned(message.playerId);
+    writer.writeSigned(message.cardId);
+    writer.finish();
+}
+
+void encodeSeed(std::vector<uint8_t>& out, uint64_t seed)
+{
+    Writer writer(out, MessageType::SEED);
+    writer.writeVarint(seed);
+    writer.finish();
+}
+
+void encodeShuffle(std::vector<uint8_t>& out, std::span<const int32_t> order)
+{
+    Writer writer(out, MessageType::SHUFFLE);
+    writer.writeVarint(order.size());
+    for (auto index : order)
+        writer.writeSigned(index);
+    writer.finish();
+}
+
+void encodeDeal(std::vector<uint8_t>& out, std::span<const DealEntry> entries)
+{
+    Writer writer(out, MessageType::DEAL);
+    writer.writeVarint(entries.size());
+    for (auto& entry : entries)
+    {
+        writer.writeSigned(entry.cardId);
+        writer.writeSigned(entry.zoneIndex);
+    }
+    writer.finish();
+}
+
+void encodeStateDelta(std::vector<uint8_t>& out, uint32_t fromVersion, uint32_t toVersion,
+                      std::span<const CardDelta> deltas)
+{
+    Writer writer(out, MessageType::STATE_DELTA);
+    writer.writeVarint(fromVersion);
+    writer.writeVarint(toVersion);
+    writer.writeVarint(deltas.size());
+    for (auto& delta : deltas)
+    {
+        writer.writeSigned(delta.cardId);
+        writer.writeSigned(delta.zoneIndex);
+        writer.writeSigned(delta.order);
+        writer.writeSigned(delta.owner);
+        writer.writeVarint(delta.isFaceUp ? 1 : 0);
+    }
+    writer.finish();
+}
+
+bool decodeMove(std::span<const uint8_t> payload, MoveMessage& message)
+{
+    Reader reader(payload);
+    return reader.readInt(message.playerId) && reader.readInt(message.cardId);
+}
+
+bool decodeSeed(std::span<const uint8_t> payload, uint64_t& seed)
+{
+    Reader reader(payload);
+    return reader.readVarint(seed);
+}
+
+bool decodeShuffle(std::span<const uint8_t> payload, ShuffleMessage& message)
+{
+    Reader reader(payload);
+    if (!readCount(reader, message.count, 1))
+        return false;
+    message.order = reader;
+    return true;
+}
+
+bool decodeDeal(std::span<const uint8_t> payload, DealMessage& message)
+{
+    Reader reader(payload);
+    if (!readCount(reader, message.count, 2))
+        return false;
+    message.entries = reader;
+    return true;
+}
+
+bool decodeStateDelta(std::span<const uint8_t> payload, StateDeltaMessage& message)
+{
+    Reader reader(payload);
+    uint64_t fromVersion, toVersion;
+    if (!reader.readVarint(fromVersion) || !reader.readVarint(toVersion) || !readCount(reader, message.count, 5))
+        return false;
+    message.fromVersion = uint32_t(fromVersion);
+    message.toVersion   = uint32_t(toVersion);
+    message.entries     = reader;
+    return true;
+}
+
+bool readDealEntry(Reader& reader, DealEntry& entry)
+{
+    return reader.readInt(entry.cardId) && reader.readInt(entry.zoneIndex);
+}
+
+bool readCardDelta(Reader& reader, CardDelta& delta)
+{
+    uint64_t flags;
+    if (!reader.readInt(delta.cardId) || !reader.readInt(delta.zoneIndex) || !reader.readInt(delta.order) ||
+        !reader.readInt(delta.owner) || !reader.readVarint(flags))
+        return false;
+    delta.isFaceUp = flags & 1;
+    return true;
+}
+}  // namespace wire
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Binary format for in-game traffic, sent as binary WebSocket frames. JSON stays in use for the lobby.
+//
+// Every frame starts with a fixed 4 byte header: u8 version, u8 message type, u16 payload size
+// (little endian). Payload fields are LEB128 varints, signed fields are zigzag encoded first.
+// Decoding reads straight from the frame bytes and never allocates; list fields are returned as a
+// Reader positioned at the first element.
+namespace wire
+{
+constexpr uint8_t VERSION        = 1;
+constexpr size_t HEADER_SIZE     = 4;
+constexpr size_t MAX_PAYLOAD     = 0xFFFF;
+constexpr size_t MAX_VARINT_SIZE = 10;
+
+enum class MessageType : uint8_t
+{
+    MOVE        = 1,  // A player put a card on the play field
+    SHUFFLE     = 2,  // Deck order, one card index per position
+    DEAL        = 3,  // Card to zone assignments
+    STATE_DELTA = 4,  // Table changes between two versions, a full snapshot when fromVersion is 0
+    SEED        = 5,  // The game's GameRandom seed
+};
+
+struct Header
+{
+    uint8_t version;
+    MessageType type;
+    uint16_t payloadSize;
+};
+
+class Reader
+{
+public:
+    Reader() = default;
+    explicit Reader(std::span<const uint8_t> bytes) : _data(bytes.data()), _end(bytes.data() + bytes.size()) {}
+
+    bool readVarint(uint64_t& value);
+    bool readSigned(int64_t& value);
+    template <typename T>
+    bool readInt(T& value)
+    {
+        int64_t v;
+        if (!readSigned(v))
+            return false;
+        value = static_cast<T>(v);
+        return true;
+    }
+
+    bool atEnd() const { return _data == _end; }
+    size_t remaining() const { return size_t(_end - _data); }
+
+private:
+    const uint8_t* _data = nullptr;
+    const uint8_t* _end  = nullptr;
+};
+
+// Appends to a caller owned buffer, reuse the buffer to keep its capacity between messages
+class Writer
+{
+public:
+    Writer(std::vector<uint8_t>& out, MessageType type);
+
+    void writeVarint(uint64_t value);
+    void writeSigned(int64_t value);
+    bool finish();  // Patches the payload size, false if the payload is too large for the header
+
+private:
+    std::vector<uint8_t>& _out;
+    size_t _start;
+};
+
+// Splits a frame into its header and payload, false for truncated frames or another protocol version
+bool decodeFrame(std::span<const uint8_t> frame, Header& header, std::span<const uint8_t>& payload);
+
+struct MoveMessage
+{
+    int32_t playerId = 0;
+    int32_t cardId   = 0;
+};
+
+struct ShuffleMessage
+{
+    uint32_t count = 0;
+    Reader order;  // count signed varints, the card index at each deck position
+};
+
+struct DealEntry
+{
+    int32_t cardId;
+    int32_t zoneIndex;
+};
+
+struct DealMessage
+{
+    uint32_t count = 0;
+    Reader entries;  // count pairs of signed varints: card id, zone index
+};
+
+struct CardDelta
+{
+    int32_t cardId;
+    int32_t zoneIndex;
+    int32_t order;  // Position inside the zone
+    int32_t owner;
+    bool isFaceUp;
+};
+
+struct StateDeltaMessage
+{
+    uint32_t fromVersion = 0;  // The version the delta applies to, 0 for a snapshot of every card
+    uint32_t toVersion   = 0;
+    uint32_t count       = 0;
+    Reader entries;  // Use readCardDelta for each of the count entries
+};
+
+void encodeMove(std::vector<uint8_t>& out, const MoveMessage& message);
+void encodeSeed(std::vector<uint8_t>& out, uint64_t seed);
+void encodeShuffle(std::vector<uint8_t>& out, std::span<const int32_t> order);
+void encodeDeal(std::vector<uint8_t>& out, std::span<const DealEntry> entries);
+void encodeStateDelta(std::vector<uint8_t>& out, uint32_t fromVersion, uint32_t toVersion,
+                      std::span<const CardDelta> deltas);
+
+bool decodeMove(std::span<const uint8_t> payload, MoveMessage& message);
+bool decodeSeed(std::span<const uint8_t> payload, uint64_t& seed);
+bool decodeShuffle(std::span<const uint8_t> payload, ShuffleMessage& message);
+bool decodeDeal(std::span<const uint8_t> payload, DealMessage& message);
+bool decodeStateDelta(std::span<const uint8_t> payload, StateDeltaMessage& message);
+
+bool readDealEntry(Reader& reader, DealEntry& entry);
+bool readCardDelta(Reader& reader, CardDelta& delta);
+}  // namespace wire
@@ -1,7 +1,10 @@
 #include "Card.h"
 #include "Zone.h"
+#include "CardFaceManager.h"
+#include "InputRouter.h"
 #include "core/event/EventCard.h"
 #include "core/const/GameConstants.h"
+#include "core/model/StateManager.h"
 
 Card* Card::create(CardData* property)
 {
@@ -26,32 +29,25 @@ bool Card::init(CardData* property)
     this->setAnchorPoint(ax::Vec2(0.5f, 0.5f));
     this->setTag(ObjectTag::CARD);
 
-    _frontSprite = ax::Sprite::create(property->frontImagePath);
-    _backSprite  = ax::Sprite::create(property->backImagePath);
-    if (!_frontSprite || !_backSprite)
+    // All cards share one back frame, the front is only loaded once the card is shown face up
+    auto backFrame = CardFaceManager::getInstance()->getBackFrame(property->backImagePath);
+    if (!backFrame)
     {
         return false;
     }
+    _backSprite = ax::Sprite::createWithSpriteFrame(backFrame);
 
-    auto cardSize = _frontSprite->getContentSize();
-    this->setContentSize(cardSize);
-
-    this->addChild(_frontSprite);
+    auto cardSize = _backSprite->getContentSize();
     this->addChild(_backSprite);
+    this->setContentSize(cardSize);
 
-    _frontSprite->setPosition(cardSize/2);
-    _backSprite->setPosition(cardSize/2);
-
-    _backSprite->setVisible(false);
-
-    // init for event
-    _mouseListener                = ax::EventListenerMouse::create();
-    _mouseListener->onMouseDown   = AX_CALLBACK_1(Card::onMouseDown, this);
-    _mouseListener->onMouseMove   = AX_CALLBACK_1(Card::onMouseMove, this);
-    _mouseListener->onMouseUp     = AX_CALLBACK_1(Card::onMouseUp, this);
-    _mouseListener->setSwallowMouse(true);
-    _eventDispatcher->addEventListenerWithSceneGraphPriority(_mouseListener, this);
+    if (_property->isFaceUp)
+    {
+        showFrontSprite();
+    }
+    _backSprite->setVisible(!_property->isFaceUp);
 
+    // Mouse input comes from the scene's InputRouter, see InputRouter::addCard
     //_keyboardListener                = ax::EventListenerKeyboard::create();
     //_keyboardListener->onKeyPressed  = AX_CALLBACK_2(MenuScene::onKeyPressed, this);
     //_keyboardListener->onKeyReleased = AX_CALLBACK_2(MenuScene::onKeyReleased, this);
@@ -63,41 +59,33 @@ bool Card::init(CardData* property)
 
 void Card::update(float delta) {}
 
-bool Card::onMouseDown(ax::Event* event)
+bool Card::onMouseDown(const ax::Vec2& mousePos)
 {
-    ax::EventMouse* e = static_cast<ax::EventMouse*>(event);
-    auto mousePos     = ax::Vec2(e->getCursorX(), e->getCursorY());
-    if (isWorldPositionInNode(this, mousePos))  // containPoint(this,mousePos))
+    // The router already resolved this card as the topmost one under the cursor
+    moveNodeToFront(this);
+    this->setGlobalZOrder(ZOrder::CARD_DRAGGING); 
+    _clicktimer.reset();
+    //_dragOffset = mousePos - getNodePositionInWorldSpace(this);
+    if (this->getNumberOfRunningActionsByTag(ActionTag::CARD_TRANSFORM_TO_ZONE) > 0)
     {
-        moveNodeToFront(this);
-        this->setGlobalZOrder(ZOrder::CARD_DRAGGING); 
-        _clicktimer.reset();
-        //_dragOffset = mousePos - getNodePositionInWorldSpace(this);
-        if (this->getNumberOfRunningActionsByTag(ActionTag::CARD_TRANSFORM_TO_ZONE) > 0)
-        {
-            // When cards are moving, clicking on it will consider as stopping it for dragging
-            this->stopActionByTag(ActionTag::CARD_TRANSFORM_TO_ZONE);
-            _isDragging = true;
-        }
-        else
-        {
-
-            _clicktimer.start();
-        }
-        _dragOffset = this->getParent()->convertToNodeSpace(mousePos) - this->getPosition();
-        return true; // Event swallowed
+        // When cards are moving, clicking on it will consider as stopping it for dragging
+        this->stopActionByTag(ActionTag::CARD_TRANSFORM_TO_ZONE);
+        _isDragging = true;
     }
+    else
+    {
 
-    return false;  // Propagate to other listeners
+        _clicktimer.start();
+    }
+    _dragOffset = this->getParent()->convertToNodeSpace(mousePos) - this->getPosition();
+    return true; // Event swallowed
 }
 
-bool Card::onMouseMove(ax::Event* event)
+bool Card::onMouseMove(const ax::Vec2& mousePos)
 {
-    ax::EventMouse* e = static_cast<ax::EventMouse*>(event);
-    auto mousePos     = ax::Vec2(e->getCursorX(), e->getCursorY());
     bool ret          = false;
     // Drag logic
-    if(!_isDraggable) return false;
+    if(!_property->isDraggable) return false;
     if (_clicktimer.count() > 0)
     {
         _clicktimer.reset();
@@ -114,10 +102,8 @@ bool Card::onMouseMove(ax::Event* event)
     return ret;
 }
 
-bool Card::onMouseUp(ax::Event* event)
+bool Card::onMouseUp(const ax::Vec2& mousePos)
 {
-    ax::EventMouse* e = static_cast<ax::EventMouse*>(event);
-    auto mousePos     = ax::Vec2(e->getCursorX(), e->getCursorY());
     bool ret          = false;
     
     if (_clicktimer.count() <= 200 && _clicktimer.count() > 0)
@@ -128,8 +114,9 @@ bool Card::onMouseUp(ax::Event* event)
     }
     else if (_isDragging)
     {
-        EventCard* event = new EventCard(this, mousePos);
-        _eventDispatcher->dispatchEvent(event);
+        Zone* targetZone = _inputRouter ? _inputRouter->hitZone(mousePos) : nullptr;
+        EventCard event(this, mousePos, targetZone);
+        _eventDispatcher->dispatchEvent(&event);
     }
     this->setGlobalZOrder(ZOrder::CARD_DEFAULT);
     _isDragging = false;
@@ -140,18 +127,65 @@ bool Card::onMouseUp(ax::Event* event)
 
 void Card::setContentSize(const ax::Size& contentSize) {
     Node::setContentSize(contentSize);
-    _frontSprite->setContentSize(contentSize);
-    _backSprite->setContentSize(contentSize);
-    _frontSprite->setPosition(contentSize / 2);
-    _backSprite->setPosition(contentSize / 2);
+    for (auto sprite : {_frontSprite, _backSprite})
+    {
+        if (sprite)
+        {
+            sprite->setContentSize(contentSize);
+            sprite->setPosition(contentSize / 2);
+        }
+    }
 }
 
 void Card::setGlobalZOrder(int z) {
     Node::setGlobalZOrder(z);
-    _frontSprite->setGlobalZOrder(z);
+    if (_frontSprite)
+        _frontSprite->setGlobalZOrder(z);
     _backSprite->setGlobalZOrder(z);
 }
 
+void Card::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags)
+{
+    // Same dirty flags the renderer uses, so the router only refreshes bounds of cards that actually moved
+    if (_inputRouter && ((parentFlags & FLAGS_DIRTY_MASK) || _transformUpdated || _contentSizeDirty))
+        _inputRouter->markDirty(this);
+    Node::visit(renderer, parentTransform, parentFlags);
+}
+
+void Card::showFrontSprite()
+{
+    if (!_frontSprite)
+    {
+        auto frontFrame = CardFaceManager::getInstance()->acquireFront(_property->frontImagePath);
+        if (!frontFrame)
+        {
+            AXLOGD("Failed to load card front {}", _property->frontImagePath);
+            return;
+        }
+        _frontSprite = ax::Sprite::createWithSpriteFrame(frontFrame);
+        this->addChild(_frontSprite);
+        _frontSprite->setContentSize(getContentSize());
+        _frontSprite->setPosition(getContentSize() / 2);
+        _frontSprite->setGlobalZOrder(getGlobalZOrder());
+    }
+    _frontSprite->setVisible(true);
+}
+
+void Card::releaseFrontSprite()
+{
+    if (!_frontSprite)
+        return;
+    _frontSprite->removeFromParent();
+    _frontSprite = nullptr;
+    CardFaceManager::getInstance()->releaseFront(_property->frontImagePath);
+}
+
+void Card::prefetchFront()
+{
+    if (!_frontSprite)
+        CardFaceManager::getInstance()->prefetchFront(_property->frontImagePath);
+}
+
 void Card::flip(float duration) {
     auto runningFlipAction = this->getActionByTag(ActionTag::CARD_FLIP);
     if (runningFlipAction)
@@ -159,18 +193,18 @@ void Card::flip(float duration) {
         return;
     }
 
-    _isFaceUp        = !_isFaceUp;
+    setFaceUp(!_property->isFaceUp);
     auto scaleDown   = ax::ScaleTo::create(duration / 2, 0.0f, 1.0f);
     auto scaleUp     = ax::ScaleTo::create(duration / 2, 1.0f, 1.0f);
     auto swapSprites = ax::CallFunc::create([this]() {
-        if (_isFaceUp)
+        if (_property->isFaceUp)
         {
-            _frontSprite->setVisible(true);
+            showFrontSprite();
             _backSprite->setVisible(false);
         }
         else
         {
-            _frontSprite->setVisible(false);
+            releaseFrontSprite();
             _backSprite->setVisible(true);
         }
     });
@@ -179,22 +213,22 @@ void Card::flip(float duration) {
     sequence->setTag(ActionTag::CARD_FLIP);
     this->runAction(sequence);
 
-    EventCard* event = new EventCard(this, true);
-    _eventDispatcher->dispatchEvent(event);
+    EventCard event(this, true);
+    _eventDispatcher->dispatchEvent(&event);
 }
 
 void Card::reveal() {
-    if(_isFaceUp) return;
+    if(_property->isFaceUp) return;
     flip();
 }
 
 void Card::hide() {
-    if (!_isFaceUp) return;
+    if (!_property->isFaceUp) return;
     flip();
 }   
 
 void Card::setDraggable(bool draggable) {
-    _isDraggable = draggable;
+    _property->isDraggable = draggable;
 }
 
 bool Card::getDraggable()
@@ -204,6 +238,7 @@ bool Card::getDraggable()
 
 void Card::setFaceUp(bool faceUp) {
     _property->isFaceUp = faceUp;
+    StateManager::getInstance()->getGameState()->cardStore.setFaceUp(id, faceUp);
 }
 
 bool Card::getFaceUp()
@@ -221,18 +256,20 @@ void Card::moveToZone(Zone* targetZone, float duration) {
 
 Card::~Card()
 {
+    if (_inputRouter)
+        _inputRouter->removeCard(this);
+    if (_frontSprite)
+        CardFaceManager::getInstance()->releaseFront(_property->frontImagePath);
     AX_SAFE_DELETE(_property);
 
     if (_keyboardListener)
         _eventDispatcher->removeEventListener(_keyboardListener);
-    if (_mouseListener)
-        _eventDispatcher->removeEventListener(_mouseListener);
 }
 
 void Card::lockInput() {
-    _mouseListener->setEnabled(false);
+    _isInputLocked = true;
 }
 
 void Card::unlockInput() {
-    _mouseListener->setEnabled(true);
+    _isInputLocked = false;
 }
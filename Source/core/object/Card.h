@@ -13,6 +13,7 @@
 #include "utils/Timer.hpp"
 
 class Zone;
+class InputRouter;
 
 class Card : public ax::Node, public ILockableInput
 {
@@ -28,20 +29,25 @@ public:
     void lockInput() override;
     void unlockInput() override;
 
-    // Input handlers
-    bool onMouseDown(ax::Event* event);
-    bool onMouseMove(ax::Event* event);
-    bool onMouseUp(ax::Event* event);
+    bool isInputLocked() const { return _isInputLocked; }
+
+    // Input handlers, called by the InputRouter with the cursor in world space
+    bool onMouseDown(const ax::Vec2& mousePos);
+    bool onMouseMove(const ax::Vec2& mousePos);
+    bool onMouseUp(const ax::Vec2& mousePos);
+    void setInputRouter(InputRouter* router) { _inputRouter = router; }
 
     // Overrides
     void setContentSize(const ax::Size& contentSize) override;
     void setVecScale(const ax::Vec2& scale) { setScaleX(scale.x); setScaleY(scale.y); };
     void setGlobalZOrder(int z);
+    void visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags) override;
 
     // Actions
     virtual void flip(float duration = 1.f);
     virtual void reveal();
     virtual void hide();
+    void prefetchFront();  // Start decoding the front before it is revealed
 
     // Getters and Setters
     void setId(int id) { this->id = id; }
@@ -62,25 +68,24 @@ public:
     ~Card() override;
 
 protected:
+    void showFrontSprite();
+    void releaseFrontSprite();
+
     lib::Timer _clicktimer = lib::Timer(false);  // time elapsed since last click but not yet moved
     ax::Vec2 _dragOffset;
     bool _isDragging = false;
 
     // Events
     ax::EventListenerKeyboard* _keyboardListener = nullptr;
-    ax::EventListenerMouse* _mouseListener       = nullptr;
+    InputRouter* _inputRouter = nullptr;
+    bool _isInputLocked = false;
 
-    CardData* _property = new CardData();
-    ax::Sprite* _frontSprite = nullptr;
+    CardData* _property = nullptr;  // Owned, set by init
+    ax::Sprite* _frontSprite = nullptr;  // Only exists while the card shows its front
     ax::Sprite* _backSprite = nullptr;
 
     std::map<std::string, int> _valueMap;
     int id = 0;  // Temp id for testing, should be replaced by a more robust system
 
     Zone* _currentZone = nullptr;
-
-    //alias for property
-    bool& _isFaceUp = _property->isFaceUp;
-    bool& _isDraggable = _property->isDraggable;
-    
 };
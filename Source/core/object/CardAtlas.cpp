@@ -0,0 +1,35 @@
+#include "CardAtlas.h"
+
+#include "utils/helper.h"
+
+bool CardAtlas::loadIndex(const std::string& indexPath)
+{
+    auto fileUtils = ax::FileUtils::getInstance();
+    if (!fileUtils->isFileExist(indexPath))
+    {
+        AXLOGD("Card atlas index {} not found, using loose images", indexPath);
+        return false;
+    }
+
+    auto frameCache = ax::SpriteFrameCache::getInstance();
+    for (auto& sheet : split(getTextFileContent(indexPath), '\n'))
+    {
+        if (!sheet.empty() && sheet.back() == '\r')
+            sheet.pop_back();
+        if (!sheet.empty() && !frameCache->isSpriteFramesWithFileLoaded(sheet))
+            frameCache->addSpriteFramesWithFile(sheet);
+    }
+    return true;
+}
+
+ax::SpriteFrame* CardAtlas::findFrame(const std::string& imagePath)
+{
+    return ax::SpriteFrameCache::getInstance()->findFrame(imagePath);
+}
+
+ax::Sprite* CardAtlas::createSprite(const std::string& imagePath)
+{
+    if (auto frame = findFrame(imagePath))
+        return ax::Sprite::createWithSpriteFrame(frame);
+    return ax::Sprite::create(imagePath);
+}
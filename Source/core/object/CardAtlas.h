@@ -0,0 +1,15 @@
+#pragma once
+
+#include "axmol.h"
+
+#include <string>
+
+// Card faces packed by Content/card/pack_atlas.py. Sprites created from the same sheet share one texture,
+// so a whole table batches into a handful of draw calls. Images missing from every sheet load as loose files.
+class CardAtlas
+{
+public:
+    static bool loadIndex(const std::string& indexPath);  // Adds every sheet listed in the frame index to the SpriteFrameCache
+    static ax::SpriteFrame* findFrame(const std::string& imagePath);
+    static ax::Sprite* createSprite(const std::string& imagePath);
+};
@@ -0,0 +1,149 @@
+#include "CardFaceManager.h"
+#include "CardAtlas.h"
+
+CardFaceManager* CardFaceManager::_instance = nullptr;
+
+ax::SpriteFrame* CardFaceManager::createFrame(const std::string& imagePath, ax::Texture2D* texture, bool& isFromAtlas)
+{
+    isFromAtlas = false;
+    if (auto frame = CardAtlas::findFrame(imagePath))
+    {
+        isFromAtlas = true;
+        return frame;
+    }
+    if (!texture)
+        texture = ax::Director::getInstance()->getTextureCache()->addImage(imagePath);
+    if (!texture)
+        return nullptr;
+    return ax::SpriteFrame::createWithTexture(texture, ax::Rect(ax::Vec2::ZERO, texture->getContentSize()));
+}
+
+ax::SpriteFrame* CardFaceManager::getBackFrame(const std::string& imagePath)
+{
+    auto it = _backFrames.find(imagePath);
+    if (it != _backFrames.end())
+        return it->second;
+
+    bool isFromAtlas;
+    auto frame = createFrame(imagePath, nullptr, isFromAtlas);
+    if (frame)
+    {
+        frame->retain();
+        _backFrames[imagePath] = frame;
+    }
+    return frame;
+}
+
+CardFaceManager::FaceEntry* CardFaceManager::loadFront(const std::string& imagePath, ax::Texture2D* texture)
+{
+    auto it = _fronts.find(imagePath);
+    if (it != _fronts.end())
+        return &it->second;
+
+    FaceEntry entry;
+    entry.frame = createFrame(imagePath, texture, entry.isFromAtlas);
+    if (!entry.frame)
+        return nullptr;
+    entry.frame->retain();
+    if (!entry.isFromAtlas)
+    {
+        auto frameTexture = entry.frame->getTexture();
+        entry.bytes = static_cast<size_t>(frameTexture->getPixelsWide()) * frameTexture->getPixelsHigh() *
+                      frameTexture->getBitsPerPixelForFormat() / 8;
+    }
+    _residentBytes += entry.bytes;
+    return &_fronts.emplace(imagePath, entry).first->second;
+}
+
+ax::SpriteFrame* CardFaceManager::acquireFront(const std::string& imagePath)
+{
+    FaceEntry* entry = loadFront(imagePath);
+    if (!entry)
+        return nullptr;
+    if (entry->isIdle)
+    {
+        _idleFronts.erase(entry->lruIterator);
+        entry->isIdle = false;
+    }
+    entry->users++;
+    trim();
+    return entry->frame;
+}
+
+void CardFaceManager::releaseFront(const std::string& imagePath)
+{
+    auto it = _fronts.find(imagePath);
+    if (it == _fronts.end() || it->second.users == 0)
+        return;
+    if (--it->second.users == 0)
+    {
+        markIdle(imagePath, it->second);
+        trim();
+    }
+}
+
+void CardFaceManager::prefetchFront(const std::string& imagePath, std::function<void()> onLoaded)
+{
+    if (_fronts.count(imagePath) || CardAtlas::findFrame(imagePath))
+    {
+        if (onLoaded)
+            onLoaded();
+        return;
+    }
+
+    ax::Director::getInstance()->getTextureCache()->addImageAsync(
+        imagePath, [this, imagePath, onLoaded](ax::Texture2D* texture) {
+        if (texture && !_fronts.count(imagePath))
+        {
+            if (FaceEntry* entry = loadFront(imagePath, texture))
+            {
+                markIdle(imagePath, *entry);
+                trim();
+            }
+        }
+        if (onLoaded)
+            onLoaded();
+    });
+}
+
+void CardFaceManager::markIdle(const std::string& imagePath, FaceEntry& entry)
+{
+    if (entry.isIdle)
+        _idleFronts.erase(entry.lruIterator);
+    entry.lruIterator = _idleFronts.insert(_idleFronts.end(), imagePath);
+    entry.isIdle      = true;
+}
+
+void CardFaceManager::evict(const std::string& imagePath)
+{
+    auto it = _fronts.find(imagePath);
+    if (it == _fronts.end())
+        return;
+    FaceEntry& entry = it->second;
+    if (entry.isIdle)
+        _idleFronts.erase(entry.lruIterator);
+    _residentBytes -= entry.bytes;
+    auto texture = entry.frame->getTexture();
+    entry.frame->release();
+    if (!entry.isFromAtlas)
+        ax::Director::getInstance()->getTextureCache()->removeTexture(texture);
+    _fronts.erase(it);
+}
+
+void CardFaceManager::trim()
+{
+    while (_residentBytes > _budget && !_idleFronts.empty())
+        evict(_idleFronts.front());
+}
+
+void CardFaceManager::setBudget(size_t bytes)
+{
+    _budget = bytes;
+    trim();
+}
+
+void CardFaceManager::purgeUnused()
+{
+    while (!_idleFronts.empty())
+        evict(_idleFronts.front());
+}
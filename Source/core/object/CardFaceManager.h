@@ -0,0 +1,63 @@
+#pragma once
+
+#include "axmol.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Owns the textures behind card faces. Back faces are shared per image for the whole deck. Front faces load on
+// first reveal (or prefetch), and fronts no card is showing are evicted least recently used first once the
+// resident size goes over budget.
+class CardFaceManager
+{
+public:
+    static CardFaceManager* getInstance()
+    {
+        if (!_instance)
+        {
+            _instance = new CardFaceManager();
+        }
+        return _instance;
+    }
+
+    ax::SpriteFrame* getBackFrame(const std::string& imagePath);
+
+    ax::SpriteFrame* acquireFront(const std::string& imagePath);  // Every acquire needs a matching release
+    void releaseFront(const std::string& imagePath);
+    // Decodes off the main thread, the front stays evictable. onLoaded runs on the main thread, also when the
+    // front was already resident or failed to load.
+    void prefetchFront(const std::string& imagePath, std::function<void()> onLoaded = nullptr);
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return _budget; }
+    size_t getResidentBytes() const { return _residentBytes; }
+
+    void purgeUnused();  // Evict every front no card is showing, e.g. on memory warnings
+
+private:
+    struct FaceEntry
+    {
+        ax::SpriteFrame* frame = nullptr;  // retained
+        size_t bytes           = 0;
+        int users              = 0;
+        bool isFromAtlas       = false;  // Sheet textures are shared with other faces and never evicted here
+        std::list<std::string>::iterator lruIterator;
+        bool isIdle = false;
+    };
+
+    CardFaceManager() = default;  // Private constructor to prevent instantiation
+    static CardFaceManager* _instance;
+
+    FaceEntry* loadFront(const std::string& imagePath, ax::Texture2D* texture = nullptr);
+    static ax::SpriteFrame* createFrame(const std::string& imagePath, ax::Texture2D* texture, bool& isFromAtlas);
+    void markIdle(const std::string& imagePath, FaceEntry& entry);
+    void evict(const std::string& imagePath);
+    void trim();
+
+    std::unordered_map<std::string, ax::SpriteFrame*> _backFrames;
+    std::unordered_map<std::string, FaceEntry> _fronts;
+    std::list<std::string> _idleFronts;  // Least recently used at the front
+    size_t _residentBytes = 0;
+    size_t _budget        = 64 * 1024 * 1024;
+};
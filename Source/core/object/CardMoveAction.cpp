@@ -0,0 +1,69 @@
+#include "CardMoveAction.h"
+
+#include <cmath>
+
+CardMoveAction* CardMoveAction::create(float duration, const ax::Vec2& position)
+{
+    CardMoveAction* action = new (std::nothrow) CardMoveAction();
+    if (action && action->initWithDuration(duration, position))
+    {
+        action->autorelease();
+        return action;
+    }
+    AX_SAFE_DELETE(action);
+    return nullptr;
+}
+
+bool CardMoveAction::initWithDuration(float duration, const ax::Vec2& position)
+{
+    if (!ActionInterval::initWithDuration(duration))
+    {
+        return false;
+    }
+    _targetPosition = position;
+    return true;
+}
+
+void CardMoveAction::retarget(float duration, const ax::Vec2& position)
+{
+    auto target = _target;
+    initWithDuration(duration, position);
+    if (target)
+        startWithTarget(target);
+}
+
+CardMoveAction* CardMoveAction::clone() const
+{
+    return CardMoveAction::create(_duration, _targetPosition);
+}
+
+CardMoveAction* CardMoveAction::reverse() const
+{
+    AXASSERT(false, "CardMoveAction has no reverse");
+    return nullptr;
+}
+
+void CardMoveAction::startWithTarget(ax::Node* target)
+{
+    ActionInterval::startWithTarget(target);
+    _startPosition = target->getPosition();
+    _startRotation = target->getRotation();
+    _startScale    = ax::Vec2(target->getScaleX(), target->getScaleY());
+
+    // Shortest way back to 0 degrees, as RotateTo does
+    _rotationDelta = -std::fmod(_startRotation, 360.f);
+    if (_rotationDelta > 180.f)
+        _rotationDelta -= 360.f;
+    else if (_rotationDelta < -180.f)
+        _rotationDelta += 360.f;
+}
+
+void CardMoveAction::update(float time)
+{
+    if (!_target)
+        return;
+    _target->setPosition(_startPosition.lerp(_targetPosition, time));
+    _target->setRotation(_startRotation + _rotationDelta * time);
+    _target->setScaleX(_startScale.x + (1.f - _startScale.x) * time);
+    _target->setScaleY(_startScale.y + (1.f - _startScale.y) * time);
+}
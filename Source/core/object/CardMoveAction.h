@@ -0,0 +1,30 @@
+#pragma once
+
+#include "axmol.h"
+
+// Moves a card to its slot in a zone while straightening its rotation and scale, like the Spawn of
+// MoveTo/RotateTo/ScaleTo it replaces. A running action can be retargeted in place when the zone
+// layout changes, so a relayout does not stop and allocate a new action for every card.
+class CardMoveAction : public ax::ActionInterval
+{
+public:
+    static CardMoveAction* create(float duration, const ax::Vec2& position);
+    bool initWithDuration(float duration, const ax::Vec2& position);
+
+    // Restarts from wherever the card is now towards the new position
+    void retarget(float duration, const ax::Vec2& position);
+    const ax::Vec2& getTargetPosition() const { return _targetPosition; }
+
+    // Overrides
+    CardMoveAction* clone() const override;
+    CardMoveAction* reverse() const override;
+    void startWithTarget(ax::Node* target) override;
+    void update(float time) override;
+
+protected:
+    ax::Vec2 _startPosition;
+    ax::Vec2 _targetPosition;
+    float _startRotation = 0.f;
+    float _rotationDelta = 0.f;
+    ax::Vec2 _startScale;
+};
@@ -0,0 +1,75 @@
+#include "CardTexturePreloader.h"
+#include "CardAtlas.h"
+#include "CardFaceManager.h"
+
+#include <unordered_set>
+
+void CardTexturePreloader::start(const std::vector<std::string>& frontImagePaths,
+                                 const std::vector<std::string>& backImagePaths,
+                                 ProgressCallback onProgress,
+                                 std::function<void()> onComplete)
+{
+    cancel();
+    _state             = std::make_shared<State>();
+    _state->onProgress = onProgress;
+    _state->onComplete = onComplete;
+
+    std::unordered_set<std::string> fronts(frontImagePaths.begin(), frontImagePaths.end());
+    std::unordered_set<std::string> backs(backImagePaths.begin(), backImagePaths.end());
+    _state->total = fronts.size() + backs.size();
+    if (_state->total == 0)
+    {
+        if (onComplete)
+            onComplete();
+        return;
+    }
+
+    auto state = _state;  // Keeps the counters alive for callbacks that outlive this preloader
+    for (auto& path : fronts)
+    {
+        CardFaceManager::getInstance()->prefetchFront(path, [state]() {
+            onImageLoaded(state);
+        });
+    }
+
+    // Backs are shared and never evicted, only their decode is moved off the main thread
+    auto textureCache = ax::Director::getInstance()->getTextureCache();
+    for (auto& path : backs)
+    {
+        if (CardAtlas::findFrame(path))
+        {
+            onImageLoaded(state);
+            continue;
+        }
+        textureCache->addImageAsync(path, [state, path](ax::Texture2D* texture) {
+            if (!state->cancelled)
+                CardFaceManager::getInstance()->getBackFrame(path);
+            onImageLoaded(state);
+        });
+    }
+}
+
+void CardTexturePreloader::onImageLoaded(const std::shared_ptr<State>& state)
+{
+    if (state->cancelled)
+        return;
+    state->loaded++;
+    if (state->onProgress)
+        state->onProgress(state->loaded, state->total);
+    if (state->loaded == state->total && state->onComplete)
+        state->onComplete();
+}
+
+void CardTexturePreloader::cancel()
+{
+    if (_state)
+        _state->cancelled = true;
+    _state = nullptr;
+}
+
+float CardTexturePreloader::getProgress() const
+{
+    if (!_state || _state->total == 0)
+        return 1.f;
+    return static_cast<float>(_state->loaded) / _state->total;
+}
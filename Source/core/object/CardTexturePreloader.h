@@ -0,0 +1,42 @@
+#pragma once
+
+#include "axmol.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Decodes card images on the texture cache's loader thread ahead of a game, so the scene that creates the
+// cards finds every texture resident. Callbacks run on the main thread and stop once the preloader is
+// cancelled or destroyed.
+class CardTexturePreloader
+{
+public:
+    using ProgressCallback = std::function<void(size_t loaded, size_t total)>;
+
+    ~CardTexturePreloader() { cancel(); }
+
+    void start(const std::vector<std::string>& frontImagePaths,
+               const std::vector<std::string>& backImagePaths,
+               ProgressCallback onProgress,
+               std::function<void()> onComplete);
+    void cancel();
+
+    bool isDone() const { return _state && _state->loaded == _state->total; }
+    float getProgress() const;
+
+private:
+    struct State
+    {
+        size_t loaded   = 0;
+        size_t total    = 0;
+        bool cancelled  = false;
+        ProgressCallback onProgress;
+        std::function<void()> onComplete;
+    };
+
+    static void onImageLoaded(const std::shared_ptr<State>& state);
+
+    std::shared_ptr<State> _state;
+};
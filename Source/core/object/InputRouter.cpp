@@ -0,0 +1,190 @@
+#include "InputRouter.h"
+#include "Card.h"
+#include "Zone.h"
+#include "core/const/GameConstants.h"
+
+#include <algorithm>
+
+InputRouter* InputRouter::create()
+{
+    InputRouter* router = new (std::nothrow) InputRouter();
+    if (router && router->init())
+    {
+        router->autorelease();
+        return router;
+    }
+    AX_SAFE_DELETE(router);
+    return nullptr;
+}
+
+bool InputRouter::init()
+{
+    if (!Node::init())
+    {
+        return false;
+    }
+
+    _mouseListener              = ax::EventListenerMouse::create();
+    _mouseListener->onMouseDown = AX_CALLBACK_1(InputRouter::onMouseDown, this);
+    _mouseListener->onMouseMove = AX_CALLBACK_1(InputRouter::onMouseMove, this);
+    _mouseListener->onMouseUp   = AX_CALLBACK_1(InputRouter::onMouseUp, this);
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(_mouseListener, this);
+    return true;
+}
+
+void InputRouter::addCard(Card* card)
+{
+    _cards.push_back(card);
+    card->setInputRouter(this);
+    markDirty(card);
+}
+
+void InputRouter::removeCard(Card* card)
+{
+    _cards.erase(std::remove(_cards.begin(), _cards.end(), card), _cards.end());
+    _cardGrid.remove(card);
+    _dirty.erase(card);
+    card->setInputRouter(nullptr);
+    if (_activeCard == card)
+        _activeCard = nullptr;
+}
+
+void InputRouter::addZone(Zone* zone)
+{
+    _zones.push_back(zone);
+    zone->setInputRouter(this);
+    markDirty(zone);
+}
+
+void InputRouter::removeZone(Zone* zone)
+{
+    _zones.erase(std::remove(_zones.begin(), _zones.end(), zone), _zones.end());
+    _zoneGrid.remove(zone);
+    _dirty.erase(zone);
+    zone->setInputRouter(nullptr);
+}
+
+void InputRouter::markDirty(ax::Node* node)
+{
+    _dirty.insert(node);
+}
+
+void InputRouter::flushDirty()
+{
+    for (auto node : _dirty)
+    {
+        auto& grid = node->getTag() == ObjectTag::CARD ? _cardGrid : _zoneGrid;
+        grid.update(node, getWorldBounds(node));
+    }
+    _dirty.clear();
+}
+
+Card* InputRouter::hitCard(const ax::Vec2& worldPosition)
+{
+    flushDirty();
+    Card* top = nullptr;
+    _cardGrid.query(worldPosition, [&](ax::Node* node) {
+        auto card = static_cast<Card*>(node);
+        if (card->isInputLocked() || !card->isVisible())
+            return;
+        if (top && !isDrawnAbove(card, top))
+            return;
+        // The grid holds axis aligned bounds, rotated cards still need the exact test
+        if (isWorldPositionInNode(card, worldPosition))
+            top = card;
+    });
+    return top;
+}
+
+Zone* InputRouter::hitZone(const ax::Vec2& worldPosition)
+{
+    flushDirty();
+    Zone* top = nullptr;
+    _zoneGrid.query(worldPosition, [&](ax::Node* node) {
+        auto zone = static_cast<Zone*>(node);
+        if (zone->isInputLocked())
+            return;
+        if (top && !isDrawnAbove(zone, top))
+            return;
+        if (isWorldPositionInNode(zone, worldPosition))
+            top = zone;
+    });
+    return top;
+}
+
+bool InputRouter::onMouseDown(ax::Event* event)
+{
+    ax::EventMouse* e = static_cast<ax::EventMouse*>(event);
+    auto mousePos     = ax::Vec2(e->getCursorX(), e->getCursorY());
+    auto card         = hitCard(mousePos);
+    if (card && card->onMouseDown(mousePos))
+    {
+        _activeCard = card;
+        event->stopPropagation();
+        return true;
+    }
+    return false;
+}
+
+bool InputRouter::onMouseMove(ax::Event* event)
+{
+    if (!_activeCard)
+        return false;
+    ax::EventMouse* e = static_cast<ax::EventMouse*>(event);
+    return _activeCard->onMouseMove(ax::Vec2(e->getCursorX(), e->getCursorY()));
+}
+
+bool InputRouter::onMouseUp(ax::Event* event)
+{
+    if (!_activeCard)
+        return false;
+    ax::EventMouse* e = static_cast<ax::EventMouse*>(event);
+    auto card         = _activeCard;
+    _activeCard       = nullptr;
+    return card->onMouseUp(ax::Vec2(e->getCursorX(), e->getCursorY()));
+}
+
+ax::Rect InputRouter::getWorldBounds(ax::Node* node)
+{
+    ax::Rect local(ax::Vec2::ZERO, node->getContentSize());
+    return ax::RectApplyTransform(local, node->getNodeToWorldTransform());
+}
+
+// Same order the renderer uses: global z order first, then scene graph order
+bool InputRouter::isDrawnAbove(ax::Node* a, ax::Node* b)
+{
+    if (a->getGlobalZOrder() != b->getGlobalZOrder())
+        return a->getGlobalZOrder() > b->getGlobalZOrder();
+
+    std::vector<ax::Node*> pathA, pathB;
+    for (auto node = a; node; node = node->getParent())
+        pathA.push_back(node);
+    for (auto node = b; node; node = node->getParent())
+        pathB.push_back(node);
+
+    // Walk down from the root until the paths split
+    auto itA = pathA.rbegin();
+    auto itB = pathB.rbegin();
+    while (itA != pathA.rend() && itB != pathB.rend() && *itA == *itB)
+    {
+        ++itA;
+        ++itB;
+    }
+    if (itA == pathA.rend())
+        return false;  // a is an ancestor of b, drawn before it
+    if (itB == pathB.rend())
+        return true;
+    if ((*itA)->getLocalZOrder() != (*itB)->getLocalZOrder())
+        return (*itA)->getLocalZOrder() > (*itB)->getLocalZOrder();
+    // Siblings with the same z are drawn in child order, which puts the latest added last
+    auto& siblings = (*itA)->getParent()->getChildren();
+    return siblings.getIndex(*itA) > siblings.getIndex(*itB);
+}
+
+InputRouter::~InputRouter()
+{
+    for (auto card : _cards)
+        card->setInputRouter(nullptr);
+    for (auto zone : _zones)
+        zone->setInputRouter(nullptr);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "axmol.h"
+
+#include "SpatialGrid.h"
+
+#include <unordered_set>
+#include <vector>
+
+class Card;
+class Zone;
+
+// Single mouse listener for the table. Card and zone world bounds live in a uniform grid that is only
+// refreshed for nodes whose transform changed, and presses go to the topmost card under the cursor
+// instead of every card testing itself.
+class InputRouter : public ax::Node
+{
+public:
+    static InputRouter* create();
+    bool init() override;
+
+    void addCard(Card* card);
+    void removeCard(Card* card);
+    void addZone(Zone* zone);
+    void removeZone(Zone* zone);
+
+    // Called by cards and zones when their world transform changed, bounds are recomputed on the next query
+    void markDirty(ax::Node* node);
+
+    Card* hitCard(const ax::Vec2& worldPosition);
+    Zone* hitZone(const ax::Vec2& worldPosition);
+
+    ~InputRouter() override;
+
+protected:
+    bool onMouseDown(ax::Event* event);
+    bool onMouseMove(ax::Event* event);
+    bool onMouseUp(ax::Event* event);
+
+    void flushDirty();
+    static ax::Rect getWorldBounds(ax::Node* node);
+    static bool isDrawnAbove(ax::Node* a, ax::Node* b);
+
+    SpatialGrid _cardGrid;
+    SpatialGrid _zoneGrid;
+    std::unordered_set<ax::Node*> _dirty;
+    std::vector<Card*> _cards;
+    std::vector<Zone*> _zones;
+    Card* _activeCard = nullptr;  // Card that took the last mouse down, receives moves until mouse up
+
+    ax::EventListenerMouse* _mouseListener = nullptr;
+};
@@ -0,0 +1,63 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+
+void SpatialGrid::update(ax::Node* node, const ax::Rect& bounds)
+{
+    auto& entry  = _entries[node];
+    entry.node   = node;
+    entry.bounds = bounds;
+
+    int minX = cellCoord(bounds.getMinX());
+    int minY = cellCoord(bounds.getMinY());
+    int maxX = cellCoord(bounds.getMaxX());
+    int maxY = cellCoord(bounds.getMaxY());
+    if (minX == entry.minX && minY == entry.minY && maxX == entry.maxX && maxY == entry.maxY)
+        return;  // Still in the same cells, small moves only touch the bounds
+
+    unlink(&entry);
+    entry.minX = minX;
+    entry.minY = minY;
+    entry.maxX = maxX;
+    entry.maxY = maxY;
+    link(&entry);
+}
+
+void SpatialGrid::remove(ax::Node* node)
+{
+    auto it = _entries.find(node);
+    if (it == _entries.end())
+        return;
+    unlink(&it->second);
+    _entries.erase(it);
+}
+
+void SpatialGrid::clear()
+{
+    _entries.clear();
+    _cells.clear();
+}
+
+void SpatialGrid::link(Entry* entry)
+{
+    for (int x = entry->minX; x <= entry->maxX; ++x)
+        for (int y = entry->minY; y <= entry->maxY; ++y)
+            _cells[cellKey(x, y)].push_back(entry);
+}
+
+void SpatialGrid::unlink(Entry* entry)
+{
+    for (int x = entry->minX; x <= entry->maxX; ++x)
+    {
+        for (int y = entry->minY; y <= entry->maxY; ++y)
+        {
+            auto cell = _cells.find(cellKey(x, y));
+            if (cell == _cells.end())
+                continue;
+            auto& list = cell->second;
+            list.erase(std::remove(list.begin(), list.end(), entry), list.end());
+            if (list.empty())
+                _cells.erase(cell);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "axmol.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid of world space bounds. A point query only looks at the nodes overlapping one cell,
+// so hit-testing does not grow with the number of nodes on the table.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(float cellSize = 128.f) : _cellSize(cellSize) {}
+
+    void update(ax::Node* node, const ax::Rect& bounds);  // Inserts the node or moves it to its new cells
+    void remove(ax::Node* node);
+    void clear();
+
+    // Calls visitor(node) for every node whose bounds contain the point
+    template <typename F>
+    void query(const ax::Vec2& point, F&& visitor) const
+    {
+        auto cell = _cells.find(cellKey(cellCoord(point.x), cellCoord(point.y)));
+        if (cell == _cells.end())
+            return;
+        for (auto entry : cell->second)
+        {
+            if (entry->bounds.containsPoint(point))
+                visitor(entry->node);
+        }
+    }
+
+protected:
+    struct Entry
+    {
+        ax::Node* node = nullptr;
+        ax::Rect bounds;
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;  // Covered cells, empty until inserted
+    };
+
+    int cellCoord(float value) const { return static_cast<int>(std::floor(value / _cellSize)); }
+    static uint64_t cellKey(int x, int y) { return (uint64_t(uint32_t(x)) << 32) | uint32_t(y); }
+    void link(Entry* entry);
+    void unlink(Entry* entry);
+
+    float _cellSize;
+    std::unordered_map<ax::Node*, Entry> _entries;  // Entry addresses stay stable, cells point into it
+    std::unordered_map<uint64_t, std::vector<Entry*>> _cells;
+};
@@ -1,15 +1,15 @@
 #include "Zone.h"
+#include "InputRouter.h"
+#include "CardMoveAction.h"
 
 #include "utils/helper.h"
-#include "utils/random.hpp"
 
 #include "core/event/EventCard.h"
 #include "core/const/GameConstants.h"
+#include "core/model/StateManager.h"
 
 #include <algorithm>
 
-using Random = lib::random_static;
-
 Zone* Zone::create(ZoneData* property)
 {
     Zone* zone = new (std::nothrow) Zone();
@@ -24,6 +24,7 @@ Zone* Zone::create(ZoneData* property)
 
 bool Zone::init(ZoneData* property)
 {
+    _property = property;
     this->setAnchorPoint(ax::Vec2(0.5f, 0.5f));
 
     _rectNode = ax::DrawNode::create();
@@ -45,72 +46,120 @@ void Zone::update(float delta) {}
 
 void Zone::OnCardMouseUp(ax::Event* event) {
     EventCard* cardEvent = static_cast<EventCard*>(event);
-    ax::Vec2 releasePosition = cardEvent->getReleasePosition();
-    // Check if the card belongs to this zone
-    if (isWorldPositionInNode(this, releasePosition))  // containPoint(this,mousePos))
+    // The router picked the zone under the release position, every other zone ignores the event
+    if (cardEvent->getTargetZone() == this)
     {
-        auto cardPreviousParent = cardEvent->getCard()->getParent();
-        if (dynamic_cast<Zone*>(cardPreviousParent) != this)
+        if (cardEvent->getCard()->getCurrentZone() != this)
         {
-            EventZone* zoneEvent = new EventZone(this, cardEvent->getCard());
-            _eventDispatcher->dispatchEvent(zoneEvent);
+            EventZone zoneEvent(this, cardEvent->getCard());
+            _eventDispatcher->dispatchEvent(&zoneEvent);
         }
         moveCardToThisZone(cardEvent->getCard(), 0.5f);
         cardEvent->stopPropagation();  // Stop propagation to prevent multiple zones from responding to the same card release
     }
 }
 
-// Positions will be spread on the horizontal line, without leaving the zone
-std::vector<ax::Vec2> Zone::getCurrentPositionList(ax::Vector<Card*> cardList)
+// Positions will be spread on the horizontal line, without leaving the zone. Plain arithmetic over the
+// ordered card list, no node traversal. Only slots from from on are recomputed unless the spread changed.
+size_t Zone::updatePositionList(size_t from)
 {
-    if (cardList.empty())
+    size_t size = _cardList.size();
+    from        = std::min(from, size);
+    _widthsBefore.resize(size + 1);
+    for (size_t i = from; i < size; ++i)
+        _widthsBefore[i + 1] = _widthsBefore[i] + _cardList.at(i)->getContentSize().width;
+    _positions.resize(size);
+    if (size == 0)
+        return 0;
+
+    // Centered while the cards fit, squeezed from the left edge once they do not
+    ax::Vec2 origin  = getAnchorPoint() * getContentSize();
+    float zoneWidth  = getContentSize().width;
+    float totalWidth = _widthsBefore[size];
+    float overflow   = totalWidth > zoneWidth ? totalWidth - zoneWidth : 0;
+    Spread spread;
+    spread.startX     = std::max(origin.x - totalWidth / 2, origin.x - zoneWidth / 2);
+    spread.y          = origin.y;
+    spread.firstWidth = _widthsBefore[1];
+    spread.squeeze    = overflow > 0 && totalWidth > spread.firstWidth ? overflow / (totalWidth - spread.firstWidth) : 0;
+    if (!(spread == _spread))
     {
-        cardList = castToVectorOfType<Card*>(this->getChildren());
+        _spread = spread;
+        from    = 0;  // Every slot moves
     }
-    int size              = cardList.size();
-    ax::Vec2 origin       = getAnchorPoint() * getContentSize();
-    ax::Vec2 originOffset = ax::Vec2::ZERO;
-    for (auto card : cardList)
+
+    for (size_t i = from; i < size; ++i)
     {
-        AXASSERT(card->getParent() == this, "Card list should only contain cards that are children of this zone");
-        originOffset += ax::Vec2(card->getContentSize().width/ 2, 0);  // Assuming the anchor point of the card is at its center
+        float width = _widthsBefore[i + 1] - _widthsBefore[i];
+        if (i == 0)
+        {
+            _positions[i] = ax::Vec2(spread.startX + width / 2, spread.y);
+            continue;
+        }
+        // The first card is never squeezed, every later one overlaps the one before by squeeze of its width
+        float previousEnd =
+            spread.startX + spread.firstWidth + (_widthsBefore[i] - spread.firstWidth) * (1 - spread.squeeze);
+        _positions[i] = ax::Vec2(previousEnd + width / 2 - spread.squeeze * width, spread.y);
     }
-    std::vector<ax::Vec2> positions;
-    if (size > 0)
+    return from;
+}
+
+void Zone::layoutCards(float duration, size_t from)
+{
+    for (size_t i = updatePositionList(from); i < _cardList.size(); ++i)
     {
-        ax::Vec2 previousCardEnd = ax::Vec2(std::max((origin - originOffset).x, origin.x - this->getContentSize().width / 2), origin.y);
-        float overflow           = originOffset.x * 2 > this->getContentSize().width ? originOffset.x * 2 - this->getContentSize().width : 0;
-        for (int i = 0; i < size; ++i)
+        Card* card = _cardList.at(i);
+        auto action = static_cast<CardMoveAction*>(card->getActionByTag(ActionTag::CARD_TRANSFORM_TO_ZONE));
+        if (action)
         {
-            float spacing = (i == 0) ? 0 : overflow * (cardList.at(i)->getContentSize().width / (originOffset.x * 2 - cardList.at(0)->getContentSize().width));
-            positions.push_back(previousCardEnd + ax::Vec2(cardList.at(i)->getContentSize().width / 2, 0) - ax::Vec2(spacing, 0));
-            previousCardEnd += ax::Vec2(cardList.at(i)->getContentSize().width - spacing, 0);
+            // Already heading somewhere, only touch it if its slot moved
+            if (!action->getTargetPosition().equals(_positions[i]))
+                action->retarget(duration, _positions[i]);
+        }
+        else if (!card->getPosition().equals(_positions[i]) || card->getRotation() != 0 ||
+                 card->getScaleX() != 1.f || card->getScaleY() != 1.f)
+        {
+            moveCard(card, _positions[i], duration);
         }
     }
-
-    return positions;
 }
 
 void Zone::moveCard(Card* card, const ax::Vec2& targetPosition, float duration) {
     // Card must be a child of this zone already
     AXASSERT(card->getParent() == this, "Card must be a child of this zone to move it");
 
-    ax::ActionInterval* moveAction   = ax::MoveTo::create(duration, targetPosition);
-    ax::ActionInterval* rotateAction   = ax::RotateTo::create(duration, 0);
-    ax::ActionInterval* scaleAction  = ax::ScaleTo::create(duration, 1.f);
-    ax::Spawn* spawnAction             = ax::Spawn::create(moveAction, rotateAction, scaleAction, nullptr);
-    spawnAction->setTag(ActionTag::CARD_TRANSFORM_TO_ZONE); 
-    card->runAction(spawnAction);
+    auto moveAction = CardMoveAction::create(duration, targetPosition);
+    moveAction->setTag(ActionTag::CARD_TRANSFORM_TO_ZONE); 
+    card->runAction(moveAction);
 }
 
 void Zone::shuffleCards()
 {
-    Random::shuffle(_cardList.begin(), _cardList.end());
+    auto gameState = StateManager::getInstance()->getGameState();
+    gameState->random.shuffle(_cardList.begin(), _cardList.end());
+    std::vector<int32_t> cardIds;
+    for (auto card : _cardList)
+        cardIds.push_back(card->getId());
+    gameState->cardStore.setZoneOrder(_zoneId, cardIds);
+    layoutCards();
 }
 
 void Zone::sendCardToAnotherZone(Zone* targetZone, Card* card) {
-    _cardList.erase(std::remove(_cardList.begin(), _cardList.end(), card), _cardList.end());
-    targetZone->moveCardToThisZone(card);
+    targetZone->moveCardToThisZone(card);  // Takes the card out of this zone's list
+}
+
+void Zone::removeCard(Card* card, float duration)
+{
+    auto index = _cardList.getIndex(card);
+    if (index == -1)
+        return;
+    _cardList.erase(index);
+    if (card->getCurrentZone() == this)
+    {
+        card->setCurrentZone(nullptr);
+        StateManager::getInstance()->getGameState()->cardStore.moveCard(card->getId(), CardStore::NO_ZONE);
+    }
+    layoutCards(duration, index);
 }
 
 void Zone::sortCards() {}
@@ -122,6 +171,13 @@ void Zone::setContentSize(const ax::Size& contentSize)
     _rectNode->drawRect(ax::Vec2::ZERO, contentSize, ax::Color4F::WHITE);
 }
 
+void Zone::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_inputRouter && ((parentFlags & FLAGS_DIRTY_MASK) || _transformUpdated || _contentSizeDirty))
+        _inputRouter->markDirty(this);
+    Node::visit(renderer, parentTransform, parentFlags);
+}
+
 void Zone::lockInput() {
     _mouseListener->setEnabled(false);
     _cardListener->setEnabled(false);
@@ -132,20 +188,40 @@ void Zone::unlockInput() {
     _cardListener->setEnabled(true);
 }
 
-void Zone::moveCardToThisZone(Card* card, float duration) {
+void Zone::moveCardToThisZone(Card* card, float duration, ssize_t index) {
     // Set temporary transform for smooth animation
     card->setRotation(getWorldRotation(card) - getWorldRotation(this));  // To get the absolute difference in rotation between the card and the zone and rotate it accordingly
     card->setVecScale(getWorldScale(card) / getWorldScale(this));  // To get the absolute difference in scale between the card and the zone and scale it accordingly
     
+    Zone* previousZone = card->getCurrentZone();
+    if (previousZone && previousZone != this)
+        previousZone->removeCard(card, duration);
+
+    card->stopActionByTag(ActionTag::CARD_TRANSFORM_TO_ZONE);  // Any running move was in the old parent's space
     setNewParentWithNoEffect(card, this);
+    if (_property && _property->isFaceUp)
+    {
+        card->prefetchFront();  // Decode now so the reveal does not stall
+    }
 
-    ax::Vector<Card*> _cardList = castToVectorOfType<Card*>(this->getChildren());
-    std::vector<ax::Vec2> newPositions = getCurrentPositionList();
-    for (int i = 0; i < _cardList.size(); i++)
+    if (previousZone != this)
+    {
+        if (index < 0 || index > _cardList.size())
+            index = _cardList.size();
+        _cardList.insert(index, card);
+        card->setCurrentZone(this);
+        StateManager::getInstance()->getGameState()->cardStore.moveCard(card->getId(), _zoneId, int32_t(index));
+    }
+    else
     {
-        _cardList.at(i)->stopActionByTag(ActionTag::CARD_TRANSFORM_TO_ZONE);
-        moveCard(_cardList.at(i), newPositions.at(i), duration);
+        index = _cardList.getIndex(card);  // Dropped back where it was, the slots before it did not move
     }
+    layoutCards(duration, index);
 }
 
-Zone::~Zone() {}
+Zone::~Zone()
+{
+    if (_inputRouter)
+        _inputRouter->removeZone(this);
+    AX_SAFE_DELETE(_property);
+}
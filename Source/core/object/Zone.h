@@ -3,6 +3,7 @@
 #include "axmol.h"
 
 #include "core/object/data/ZoneData.h"
+#include "core/object/data/CardStore.h"
 
 #include "Card.h"
 
@@ -14,6 +15,7 @@
 
 #include "utils/helper.h"
 
+class InputRouter;
 
 class Zone : public ax::Node, public ILockableInput
 {
@@ -32,32 +34,60 @@ public:
     void OnCardMouseUp(ax::Event* event);
 
     // Actions
-    std::vector<ax::Vec2> getCurrentPositionList(ax::Vector<Card*> cardList = ax::Vector<Card*>()); //List of positions for cards in this zone, used to update card positions when a change happens
+    const ax::Vector<Card*>& getCardList() const { return _cardList; }
+    const std::vector<ax::Vec2>& getPositionList() const { return _positions; }  // Slot of each card in getCardList order
+    // Sends every card whose slot changed towards it. Cards before from keep their slot unless the zone's
+    // spread changed, e.g. when a card was inserted or removed at from.
+    void layoutCards(float duration = 1.f, size_t from = 0);
     void moveCard(Card* card, const ax::Vec2& targetPosition, float duration = 1.f);
     void shuffleCards();
     void sendCardToAnotherZone(Zone* targetZone, Card* card);
     void sortCards();
-    void moveCardToThisZone(Card* card, float duration = 1.f);
+    void moveCardToThisZone(Card* card, float duration = 1.f, ssize_t index = -1);  // index -1 appends
+    void removeCard(Card* card, float duration = 1.f);  // Drops the card from the list, it stays a child until another zone takes it
     void getNewCardIndex(Card* card); 
     void getNewCardPosition(Card* card);
 
     // Overrides
     void setContentSize(const ax::Size& contentSize) override;
+    void visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags) override;
     void lockInput() override;
     void unlockInput() override;
+    bool isInputLocked() const { return !_cardListener->isEnabled(); }
+    void setInputRouter(InputRouter* router) { _inputRouter = router; }
     // Getters and Setters
-    
+    void setZoneId(int zoneId) { _zoneId = zoneId; }
+    int getZoneId() const { return _zoneId; }  // Index in GameState::zones, the card store's zone id
+
     // Constructor and Destructor
     ~Zone() override;
 
 protected:
+    // What every slot depends on besides the widths of the cards before it
+    struct Spread
+    {
+        float startX     = 0.f;
+        float y          = 0.f;
+        float firstWidth = 0.f;
+        float squeeze    = 0.f;  // Share of each card's width it overlaps the previous one by, once the zone is full
+        bool operator==(const Spread&) const = default;
+    };
+
+    size_t updatePositionList(size_t from);  // Returns the first slot recomputed
+
+    ZoneData* _property     = nullptr;
+    int _zoneId             = CardStore::NO_ZONE;
     ax::DrawNode* _rectNode = nullptr;
 
-    ax::Vector<Card*> _cardList;  // currently using get all children and filter by tag
+    ax::Vector<Card*> _cardList;  // Cards in this zone in layout order, the source of truth over getChildren()
+    std::vector<ax::Vec2> _positions;  // Cached slots from the last layout
+    std::vector<float> _widthsBefore;  // Total width of the cards before each slot, one more entry than cards
+    Spread _spread;
 
     // Events
     ax::EventListenerKeyboard* _keyboardListener = nullptr;
     ax::EventListenerMouse* _mouseListener       = nullptr;
     EventListenerCard* _cardListener = nullptr;
+    InputRouter* _inputRouter = nullptr;
 
 };
@@ -0,0 +1,110 @@
+#include "CardStore.h"
+
+#include <algorithm>
+
+void CardStore::clear()
+{
+    _ids.clear();
+    _zones.clear();
+    _orders.clear();
+    _owners.clear();
+    _faceUp.clear();
+    _slotById.clear();
+    _zoneCards.clear();
+}
+
+void CardStore::add(int32_t cardId, bool isFaceUp)
+{
+    if (cardId < 0 || contains(cardId))
+        return;
+    if (size_t(cardId) >= _slotById.size())
+        _slotById.resize(cardId + 1, -1);
+
+    auto slot         = int32_t(_ids.size());
+    _slotById[cardId] = slot;
+    _ids.push_back(cardId);
+    _zones.push_back(NO_ZONE);
+    _orders.push_back(0);
+    _owners.push_back(-1);
+    if (size_t(slot) / 64 >= _faceUp.size())
+        _faceUp.push_back(0);
+    setFaceUp(cardId, isFaceUp);
+}
+
+void CardStore::moveCard(int32_t cardId, int32_t zoneId, int32_t index)
+{
+    auto slot = indexOf(cardId);
+    if (slot == -1)
+        return;
+
+    auto previousZone = _zones[slot];
+    if (previousZone != NO_ZONE)
+    {
+        auto& previous = _zoneCards[previousZone];
+        auto position  = size_t(_orders[slot]);
+        previous.erase(previous.begin() + position);
+        renumber(previousZone, position);
+    }
+
+    _zones[slot]  = zoneId;
+    _orders[slot] = 0;
+    if (zoneId == NO_ZONE)
+        return;
+    if (size_t(zoneId) >= _zoneCards.size())
+        _zoneCards.resize(zoneId + 1);
+    auto& cards   = _zoneCards[zoneId];
+    auto position = index >= 0 && size_t(index) < cards.size() ? size_t(index) : cards.size();
+    cards.insert(cards.begin() + position, cardId);
+    renumber(zoneId, position);
+}
+
+void CardStore::setZoneOrder(int32_t zoneId, std::span<const int32_t> cardIds)
+{
+    if (zoneId < 0 || size_t(zoneId) >= _zoneCards.size() || cardIds.size() != _zoneCards[zoneId].size())
+        return;
+    auto& cards = _zoneCards[zoneId];
+    if (!std::is_permutation(cardIds.begin(), cardIds.end(), cards.begin()))
+        return;  // Not the zone's cards, keep the order we have
+    cards.assign(cardIds.begin(), cardIds.end());
+    renumber(zoneId, 0);
+}
+
+void CardStore::setOwner(int32_t cardId, int32_t owner)
+{
+    if (auto slot = indexOf(cardId); slot != -1)
+        _owners[slot] = owner;
+}
+
+void CardStore::setFaceUp(int32_t cardId, bool isFaceUp)
+{
+    auto slot = indexOf(cardId);
+    if (slot == -1)
+        return;
+    auto bit = uint64_t(1) << (slot % 64);
+    if (isFaceUp)
+        _faceUp[slot / 64] |= bit;
+    else
+        _faceUp[slot / 64] &= ~bit;
+}
+
+std::span<const int32_t> CardStore::getCardsInZone(int32_t zoneId) const
+{
+    if (zoneId < 0 || size_t(zoneId) >= _zoneCards.size())
+        return {};
+    return _zoneCards[zoneId];
+}
+
+size_t CardStore::countFaceUp() const
+{
+    size_t count = 0;
+    for (auto word : _faceUp)
+        count += std::popcount(word);
+    return count;
+}
+
+void CardStore::renumber(int32_t zoneId, size_t from)
+{
+    auto& cards = _zoneCards[zoneId];
+    for (size_t position = from; position < cards.size(); ++position)
+        _orders[_slotById[cards[position]]] = int32_t(position);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Every card's game state as parallel arrays, one slot per card, with no scene graph in the way.
+// Card and Zone nodes write their changes here and render from their own copies, logic queries
+// here: a card by id is one index, a zone's cards are one contiguous list in layout order and the
+// face-up cards are a bit scan.
+class CardStore
+{
+public:
+    static constexpr int32_t NO_ZONE = -1;
+
+    void clear();
+    // Ids are expected to be small and dense, as GameScene numbers cards from 0. Adding a known id does nothing.
+    void add(int32_t cardId, bool isFaceUp);
+
+    size_t size() const { return _ids.size(); }
+    int32_t indexOf(int32_t cardId) const  // The card's slot, -1 for an unknown id
+    {
+        return cardId >= 0 && size_t(cardId) < _slotById.size() ? _slotById[cardId] : -1;
+    }
+    bool contains(int32_t cardId) const { return indexOf(cardId) != -1; }
+
+    // By card id, the id must be known
+    int32_t getZone(int32_t cardId) const { return _zones[indexOf(cardId)]; }
+    int32_t getOrder(int32_t cardId) const { return _orders[indexOf(cardId)]; }
+    int32_t getOwner(int32_t cardId) const { return _owners[indexOf(cardId)]; }
+    bool isFaceUp(int32_t cardId) const { return isFaceUpAt(indexOf(cardId)); }
+
+    // Unknown ids are ignored, cards may change before they are added
+    void moveCard(int32_t cardId, int32_t zoneId, int32_t index = -1);  // index -1 appends, NO_ZONE takes the card out
+    void setZoneOrder(int32_t zoneId, std::span<const int32_t> cardIds);  // Reorders cards already in the zone
+    void setOwner(int32_t cardId, int32_t owner);
+    void setFaceUp(int32_t cardId, bool isFaceUp);
+
+    // Card ids in layout order
+    std::span<const int32_t> getCardsInZone(int32_t zoneId) const;
+    size_t countInZone(int32_t zoneId) const { return getCardsInZone(zoneId).size(); }
+
+    size_t countFaceUp() const;
+    // Calls visit(cardId) for each face-up card, in slot order
+    template <typename Visitor>
+    void forEachFaceUp(Visitor&& visit) const
+    {
+        for (size_t word = 0; word < _faceUp.size(); ++word)
+        {
+            for (auto bits = _faceUp[word]; bits; bits &= bits - 1)
+                visit(_ids[word * 64 + std::countr_zero(bits)]);
+        }
+    }
+
+    // Whole columns by slot, for bulk scans
+    std::span<const int32_t> getIds() const { return _ids; }
+    std::span<const int32_t> getZones() const { return _zones; }
+    std::span<const int32_t> getOrders() const { return _orders; }
+    std::span<const int32_t> getOwners() const { return _owners; }
+    bool isFaceUpAt(int32_t slot) const { return (_faceUp[slot / 64] >> (slot % 64)) & 1; }
+
+private:
+    void renumber(int32_t zoneId, size_t from);  // Rewrites the order of each card in the zone from position from on
+
+    std::vector<int32_t> _ids;
+    std::vector<int32_t> _zones;
+    std::vector<int32_t> _orders;  // Position inside the zone
+    std::vector<int32_t> _owners;
+    std::vector<uint64_t> _faceUp;  // One bit per slot
+
+    std::vector<int32_t> _slotById;  // -1 for ids never added
+    std::vector<std::vector<int32_t>> _zoneCards;  // Card ids of each zone in order, by zone id
+};
@@ -0,0 +1,79 @@
+#include "DeckFile.h"
+
+#include <cstring>
+#include <fstream>
+
+bool DeckFile::load(std::vector<uint8_t>&& bytes)
+{
+    _bytes = std::move(bytes);
+    return loadView(_bytes.data(), _bytes.size());
+}
+
+bool DeckFile::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return fail("cannot open " + path);
+    std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), bytes.size()))
+        return fail("cannot read " + path);
+    return load(std::move(bytes));
+}
+
+bool DeckFile::loadView(const uint8_t* data, size_t size)
+{
+    _records = {};
+    _strings = {};
+
+    if (size < sizeof(DeckFileHeader))
+        return fail("file smaller than the header");
+    DeckFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, "CDCK", 4) != 0)
+        return fail("not a deck file");
+    // Before the version, which also reads swapped
+    if (header.byteOrder == 0x04030201)
+        return fail("deck byte order does not match this machine");
+    if (header.version != VERSION)
+        return fail("unsupported deck version " + std::to_string(header.version));
+    if (header.byteOrder != BYTE_ORDER_MARK)
+        return fail("missing byte order mark");
+    if (header.recordSize != sizeof(DeckCardRecord))
+        return fail("unexpected record size " + std::to_string(header.recordSize));
+    if ((reinterpret_cast<uintptr_t>(data) + header.recordsOffset) % RECORD_ALIGNMENT != 0)
+        return fail("misaligned record array");
+
+    uint64_t recordsEnd = uint64_t(header.recordsOffset) + uint64_t(header.recordCount) * header.recordSize;
+    uint64_t stringsEnd = uint64_t(header.stringTableOffset) + header.stringTableSize;
+    if (recordsEnd > size || stringsEnd > size)
+        return fail("truncated deck file");
+    if (header.stringTableSize > 0 && data[stringsEnd - 1] != '\0')
+        return fail("unterminated string table");
+
+    _records = {reinterpret_cast<const DeckCardRecord*>(data + header.recordsOffset), header.recordCount};
+    _strings = {reinterpret_cast<const char*>(data + header.stringTableOffset), header.stringTableSize};
+    for (auto& card : _records)
+    {
+        if (card.frontSprite >= _strings.size() || card.backSprite >= _strings.size())
+        {
+            _records = {};
+            return fail("sprite offset out of range in card " + std::to_string(card.id));
+        }
+    }
+    _error.clear();
+    return true;
+}
+
+std::string_view DeckFile::getString(uint32_t offset) const
+{
+    if (offset >= _strings.size())
+        return {};
+    return std::string_view(_strings.data() + offset);  // Terminated, checked on load
+}
+
+bool DeckFile::fail(const std::string& error)
+{
+    _error = error;
+    return false;
+}
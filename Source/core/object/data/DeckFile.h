@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Binary deck compiled offline by Content/configs/compile_deck.py. Records are read in place from the file
+// bytes, so loading a deck is one read plus a header check: no parsing and no per-card allocation.
+#pragma pack(push, 1)
+struct DeckFileHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t recordCount;
+    uint32_t recordSize;
+    uint32_t recordsOffset;
+    uint32_t stringTableOffset;
+    uint32_t stringTableSize;
+    uint32_t byteOrder;  // BYTE_ORDER_MARK as written, reads differently on a machine of the other endianness
+};
+
+struct DeckCardRecord
+{
+    int32_t id;
+    float posX;
+    float posY;
+    uint32_t frontSprite;  // Offsets into the string table
+    uint32_t backSprite;
+    float sizeX;
+    float sizeY;
+    float rotation;
+    uint32_t amount;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(DeckFileHeader) == 32, "DeckFileHeader must match compile_deck.py");
+static_assert(sizeof(DeckCardRecord) == 36, "DeckCardRecord must match compile_deck.py");
+static_assert(alignof(int32_t) <= 4 && alignof(uint32_t) <= 4 && alignof(float) <= 4,
+              "DeckCardRecord fields must fit DeckFile::RECORD_ALIGNMENT");
+
+class DeckFile
+{
+public:
+    static constexpr uint16_t VERSION         = 2;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    // Every record field is 4 bytes wide. pack(1) makes alignof(DeckCardRecord) 1, so records read in
+    // place are checked against this instead.
+    static constexpr size_t RECORD_ALIGNMENT  = 4;
+
+    // Takes ownership of the file contents
+    bool load(std::vector<uint8_t>&& bytes);
+    // Views memory owned by the caller, e.g. a mapped file, which has to outlive this object
+    bool loadView(const uint8_t* data, size_t size);
+    bool loadFromFile(const std::string& path);
+
+    bool empty() const { return _records.empty(); }
+    std::span<const DeckCardRecord> getCards() const { return _records; }
+    std::string_view getString(uint32_t offset) const;
+    std::string_view getFrontSprite(const DeckCardRecord& card) const { return getString(card.frontSprite); }
+    std::string_view getBackSprite(const DeckCardRecord& card) const { return getString(card.backSprite); }
+
+    const std::string& getError() const { return _error; }
+
+protected:
+    bool fail(const std::string& error);
+
+    std::vector<uint8_t> _bytes;
+    std::span<const DeckCardRecord> _records;
+    std::string_view _strings;
+    std::string _error;
+};
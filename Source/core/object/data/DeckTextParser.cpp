@@ -0,0 +1,173 @@
+#include "DeckTextParser.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace
+{
+constexpr int CARD_COLUMNS = 9;
+constexpr const char* CARD_COLUMN_NAMES[CARD_COLUMNS] = {"id",     "pos_x",  "pos_y",    "front_sprite", "back_sprite",
+                                                         "size_x", "size_y", "rotation", "amount"};
+
+bool isBlank(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+std::string_view trim(std::string_view text)
+{
+    while (!text.empty() && isBlank(text.front()))
+        text.remove_prefix(1);
+    while (!text.empty() && isBlank(text.back()))
+        text.remove_suffix(1);
+    return text;
+}
+
+template <typename T>
+bool parseNumber(std::string_view token, T& value)
+{
+    auto end    = token.data() + token.size();
+    auto result = std::from_chars(token.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+}  // namespace
+
+bool DeckTextParser::parse(std::string_view text)
+{
+    _cards.clear();
+    _strings.clear();
+    _offsets.clear();
+    _errors.clear();
+
+    std::string_view section;
+    int lineNumber = 0;
+    while (!text.empty())
+    {
+        auto lineEnd = text.find('\n');
+        auto line    = text.substr(0, lineEnd);
+        text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+        ++lineNumber;
+
+        auto content = trim(line);
+        if (content.empty() || content.front() == '#')
+            continue;
+        if (content.front() == '[')
+        {
+            section = content;
+            continue;
+        }
+        if (section == "[CARD]")
+            parseCardLine(line, lineNumber);
+    }
+
+    _offsets.clear();
+    return _errors.empty();
+}
+
+void DeckTextParser::parseCardLine(std::string_view line, int lineNumber)
+{
+    // Columns are split by any run of tabs or spaces, configs mix both
+    std::string_view columns[CARD_COLUMNS];
+    int count = 0;
+    size_t i  = 0;
+    while (i < line.size())
+    {
+        while (i < line.size() && isBlank(line[i]))
+            ++i;
+        if (i == line.size())
+            break;
+        size_t start = i;
+        while (i < line.size() && !isBlank(line[i]))
+            ++i;
+        if (count == CARD_COLUMNS)
+        {
+            error(lineNumber, int(start) + 1, "unexpected extra column");
+            return;
+        }
+        columns[count++] = line.substr(start, i - start);
+    }
+    if (count < CARD_COLUMNS)
+    {
+        error(lineNumber, int(line.size()) + 1,
+              std::string("missing column ") + CARD_COLUMN_NAMES[count]);
+        return;
+    }
+
+    DeckCardRecord card{};
+    bool valid  = true;
+    auto number = [&](int column, auto& value) {
+        if (!parseNumber(columns[column], value))
+        {
+            error(lineNumber, int(columns[column].data() - line.data()) + 1,
+                  std::string("invalid ") + CARD_COLUMN_NAMES[column] + " '" + std::string(columns[column]) + "'");
+            valid = false;
+        }
+    };
+    number(0, card.id);
+    number(1, card.posX);
+    number(2, card.posY);
+    number(5, card.sizeX);
+    number(6, card.sizeY);
+    number(7, card.rotation);
+    number(8, card.amount);
+    if (!valid)
+        return;
+
+    card.frontSprite = intern(columns[3]);
+    card.backSprite  = intern(columns[4]);
+    _cards.push_back(card);
+}
+
+uint32_t DeckTextParser::intern(std::string_view text)
+{
+    auto it = _offsets.find(text);
+    if (it != _offsets.end())
+        return it->second;
+    auto offset = uint32_t(_strings.size());
+    _strings.append(text);
+    _strings.push_back('\0');
+    _offsets.emplace(text, offset);
+    return offset;
+}
+
+std::string_view DeckTextParser::getString(uint32_t offset) const
+{
+    if (offset >= _strings.size())
+        return {};
+    return std::string_view(_strings.c_str() + offset);
+}
+
+std::string DeckTextParser::getErrorText() const
+{
+    if (_errors.empty())
+        return {};
+    auto& first = _errors.front();
+    return std::to_string(first.line) + ":" + std::to_string(first.column) + ": " + first.message;
+}
+
+std::vector<uint8_t> DeckTextParser::build() const
+{
+    DeckFileHeader header{};
+    std::memcpy(header.magic, "CDCK", 4);
+    header.version           = DeckFile::VERSION;
+    header.headerSize        = sizeof(DeckFileHeader);
+    header.recordCount       = uint32_t(_cards.size());
+    header.recordSize        = sizeof(DeckCardRecord);
+    header.recordsOffset     = sizeof(DeckFileHeader);
+    header.stringTableOffset = header.recordsOffset + header.recordCount * header.recordSize;
+    header.stringTableSize   = uint32_t(_strings.size());
+    header.byteOrder         = DeckFile::BYTE_ORDER_MARK;
+
+    std::vector<uint8_t> bytes(header.stringTableOffset + header.stringTableSize);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    if (!_cards.empty())
+        std::memcpy(bytes.data() + header.recordsOffset, _cards.data(), _cards.size() * sizeof(DeckCardRecord));
+    if (!_strings.empty())
+        std::memcpy(bytes.data() + header.stringTableOffset, _strings.data(), _strings.size());
+    return bytes;
+}
+
+void DeckTextParser::error(int line, int column, std::string message)
+{
+    _errors.push_back({line, column, std::move(message)});
+}
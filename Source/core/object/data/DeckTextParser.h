@@ -0,0 +1,45 @@
+#pragma once
+
+#include "DeckFile.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct DeckParseError
+{
+    int line;
+    int column;
+    std::string message;
+};
+
+// Single pass parser for text deck configs (e.g. ascension.txt). Tokens are views into the source text,
+// numbers are read in place and each distinct sprite path is stored once in the string table.
+// The result has the same layout as a compiled deck, see build().
+class DeckTextParser
+{
+public:
+    // Keeps parsing after an error so every bad line is reported, returns false if there was any
+    bool parse(std::string_view text);
+
+    const std::vector<DeckCardRecord>& getCards() const { return _cards; }
+    std::string_view getString(uint32_t offset) const;
+    const std::vector<DeckParseError>& getErrors() const { return _errors; }
+    // First error as "line:column: message"
+    std::string getErrorText() const;
+
+    // Serializes to the compiled deck format, for DeckFile::load or to write a .deck file
+    std::vector<uint8_t> build() const;
+
+protected:
+    void parseCardLine(std::string_view line, int lineNumber);
+    uint32_t intern(std::string_view text);
+    void error(int line, int column, std::string message);
+
+    std::vector<DeckCardRecord> _cards;
+    std::string _strings;
+    std::unordered_map<std::string_view, uint32_t> _offsets;  // Keys view the source text, only valid during parse
+    std::vector<DeckParseError> _errors;
+};
@@ -1 +1,10 @@
 #include "Command.h"
+#include "core/network/RequestScheduler.h"
+#include "core/network/MessageRouter.h"
+
+Command::~Command()
+{
+    // Requests still in flight and routed socket messages must not call back into a destroyed command
+    RequestScheduler::getInstance()->cancelOwner(this);
+    MessageRouter::getInstance()->removeOwner(this);
+}
@@ -2,28 +2,11 @@
 
 #include "axmol.h"
 #include "Command.h"
+#include "core/logic/PhaseCore.h"
 
-class Phase : public ax::Node
+class Phase : public ax::Node, public PhaseCore
 {
-    enum class State {
-        prepare,
-        main,
-        done
-    };
-
 public:
     Phase(std::vector<Command*> &commandList, bool isRepeating = false);
     ~Phase();
-    virtual void startPhase();
-    void executeCommand();
-    void update(float delta) override;
-    bool isDone() const { return _isDone; }
-
-protected:
-    //std::vector<Command*> _commandList;
-    std::vector<Command*> _commandList;
-    int _currentCommandIndex = 0;
-    State _currentState = State::prepare;
-    bool _isDone             = false;
-    bool _isRepeating        = false;  // Flag to indicate if the phase should repeat after completion
 };
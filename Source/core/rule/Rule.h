@@ -2,37 +2,10 @@
 
 #include "axmol.h"
 #include "Turn.h"
+#include "core/logic/RuleCore.h"
 
-class Rule : public ax::Node
+class Rule : public ax::Node, public RuleCore
 {
-    enum class State {
-        start,
-        main,
-        end
-    };
-
 public:
     Rule(Turn* prepareTurn, Turn* mainTurn, Turn* endTurn);
-    ~Rule() { unscheduleUpdate(); }
-
-    void startRule() {
-        executeTurn();
-    }
-
-    void executeTurn() {
-        if (_currentTurn) {
-            _currentTurn->startTurn();
-        }
-    }
-
-    void update(float delta);
-
-protected:
-    Turn* _startTurn;
-    Turn* _mainTurn;
-    Turn* _endTurn;
-    Turn* _currentTurn = nullptr;
-
-    State _currentState = State::start;
-
 };
@@ -1,10 +1,3 @@
 #include "Turn.h"
 
-Turn::Turn(Phase* mainPhase) : _mainPhase(mainPhase) {
-    this->scheduleUpdate();
-}
-
-void Turn::startTurn()
-{
-    _mainPhase->startPhase();
-}
+Turn::Turn(Phase* mainPhase) : TurnCore(mainPhase) {}
@@ -9,12 +9,16 @@ void DealCommand::execute() {
     setRunning(true);
     float delay = 0.0f;
     int currentZoneIndex = 0;
+    std::vector<wire::DealEntry> dealt;
     for (int i = 0; i < cards.size(); ++i)
     {
         Card* card = cards.at(i);
         card->moveToZone(_targetZones.at(currentZoneIndex), delay += 0.5f);
+        dealt.push_back({card->getId(), currentZoneIndex});
         currentZoneIndex = (currentZoneIndex + 1) % 2; // Temp: 2 player's zone at index 0, 1
     }
+    if (auto replayLog = StateManager::getInstance()->getGameState()->replayLog)
+        replayLog->recordDeal(dealt);
     auto delayAction = ax::DelayTime::create(delay);
     auto callback = ax::CallFunc::create([this]() {
         this->setDone(true);
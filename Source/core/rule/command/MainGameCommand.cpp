@@ -1,7 +1,11 @@
 #include "MainGameCommand.h"
 #include "core/scene/GameScene.h"
 #include "core/model/StateManager.h"
-#include "core/network/HttpRequestHandler.h"
+#include "core/network/RequestScheduler.h"
+#include "core/network/protocol/BodyParser.h"
+#include "core/network/SocketNetworkManager.h"
+#include "core/network/MessageRouter.h"
+#include "core/event/EventWebSocket.h"
 
 MainGameCommand::MainGameCommand(Zone* playField) 
 {
@@ -9,21 +13,37 @@ MainGameCommand::MainGameCommand(Zone* playField)
     _zoneListener = EventListenerZone::create();
     _zoneListener->onCardReceived = AX_CALLBACK_1(MainGameCommand::onMainFieldCardReceived, this);
     _eventDispatcher->addEventListenerWithSceneGraphPriority(_zoneListener, _playField);
+
+    auto router = MessageRouter::getInstance();
+    router->on(SocketCommand::CARD_PLAYED, this, AX_CALLBACK_1(MainGameCommand::onCardPlayedMessage, this));
+    router->on(SocketCommand::MOVE, this, AX_CALLBACK_1(MainGameCommand::onMoveMessage, this));
+
+    _socketListener                    = EventListenerWebSocket::create();
+    _socketListener->onWebSocketOpen   = [this](EventWebSocket* event) { catchUp(); };
+    _socketListener->onWebSocketError  = AX_CALLBACK_1(MainGameCommand::onWebSocketClosed, this);
+    _socketListener->onWebSocketClose  = AX_CALLBACK_1(MainGameCommand::onWebSocketClosed, this);
+    _socketListener->onWebSocketResync = [this](EventWebSocket* event) { catchUp(); };
+    _eventDispatcher->addEventListenerWithFixedPriority(_socketListener, 11);
 }
 
 void MainGameCommand::execute()
 {
-    auto gameScene = static_cast<GameScene*>(ax::Director::getInstance()->getRunningScene());
-    auto cards     = StateManager::getInstance()->getGameState()->cards;
-    auto zones     = StateManager::getInstance()->getGameState()->zones;
+    auto gameState = StateManager::getInstance()->getGameState();
+    auto& zones    = gameState->zones;
     if (_firstTime)
     {
-        for (auto i : cards)
+        // Each player owns what was dealt to their hand. The deal is where the game starts, not a step to undo.
+        gameState->playTable.reset(gameState->cards.size());
+        gameState->history.clear();
+        for (int player = 0; player < 2; ++player)
         {
-            if (i->getParent() == zones[0])
-                _playerList[0].push_back(i);
-            else if (i->getParent() == zones[1])
-                _playerList[1].push_back(i);
+            for (auto cardId : gameState->cardStore.getCardsInZone(zones.at(player)->getZoneId()))
+            {
+                gameState->cardStore.setOwner(cardId, player);
+                gameState->playTable.setCard(cardId, {player, gameState->cardStore.getOrder(cardId), player,
+                                                      gameState->cardStore.isFaceUp(cardId)});
+                _playerList[player].push_back(gameState->getCard(cardId));
+            }
         }
         _firstTime = false;
         _playerList[0].push_back(zones[0]);
@@ -51,26 +71,16 @@ void MainGameCommand::onMainFieldCardReceived(EventZone* event) {
 
     _playerList[_currentPlayerIndex].erase(std::remove(_playerList[_currentPlayerIndex].begin(), _playerList[_currentPlayerIndex].end(), card), _playerList[_currentPlayerIndex].end());
 
-
-    HttpRequestHandler::sendPostRequest(
-        "/play/" + std::to_string(_currentPlayerIndex) + "/" + std::to_string(card->getId()),
-        "",
-        [this](HttpClient* client, HttpResponse* response) {
-            if (response->getResponseCode() == 200)
-            {
-                AXLOG("Play successful");
-            }
-            else
-            {
-                AXLOG("Play failed, response code: %d", response->getResponseCode());
-            }
-        }
-    );
+    // The card is still in its hand here, the zone takes it once this returns
+    auto move = new PlayCardCommand(++_lastMoveId, card, _currentPlayerIndex,
+                                    AX_CALLBACK_1(MainGameCommand::onMoveOutcome, this));
+    move->autorelease();
+    _pendingMoves.pushBack(move);
+    move->execute();
 
     if (_playerList[_currentPlayerIndex].size() == 1)
     {
-        AXLOG("%d win", _currentPlayerIndex);
-        setDone(true);
+        _isAwaitingWin = true;
         return;
     }
     setCurrentPlayerIndex(1 - _currentPlayerIndex);
@@ -90,45 +100,245 @@ void MainGameCommand::setCurrentPlayerIndex(int index) {
     }
     else
     {
-        auto callable = [this](HttpClient* client, HttpResponse* response) {
-            if (response->getResponseCode() == 200)
-            {
-                int previousPlayedCardIndex = HttpRequestHandler::convertBufferToInt(response->getResponseData());
-                auto cards                  = StateManager::getInstance()->getGameState()->cards;
-                for (auto card : cards)
-                    if (card->getId() == previousPlayedCardIndex)
-                        card->moveToZone(_playField);
-                AXLOG("Checked turn successfully, current player index: %d", _currentPlayerIndex);
-                for (auto input : _playerList[_currentPlayerIndex])
-                {
-                    input->lockInput();
-                }
-                if (_playerList[_currentPlayerIndex].size() == 1)
-                {
-                    AXLOG("%d win", _currentPlayerIndex);
-                    setDone(true);
-                    return;
-                }
-                setCurrentPlayerIndex(1 - _currentPlayerIndex);
+        waitForOpponent();
+    }
+}
 
-            }
+void MainGameCommand::waitForOpponent()
+{
+    _waitingForOpponent = true;
+    if (!SocketNetworkManager::getInstance()->isConnected())
+    {
+        longPollOpponentMove();
+        return;
+    }
+
+    // The move itself is pushed as "card_played", this one check only catches a move made before we started waiting
+    auto clientIndex = StateManager::getInstance()->getGameState()->clientPlayer->getIndex();
+    RequestScheduler::Options options;
+    options.owner     = this;
+    options.batchable = true;
+    RequestScheduler::getInstance()->get("/play/" + std::to_string(clientIndex),
+                                         [this](const RequestScheduler::Response& response) {
+        int cardIndex;
+        if (response.code == 200 && body::parseInt(response.body, cardIndex))
+            onOpponentPlayed(cardIndex);
+    }, options);
+}
+
+void MainGameCommand::longPollOpponentMove()
+{
+    if (_isLongPolling || !_waitingForOpponent)
+        return;
+    _isLongPolling = true;
+
+    // The server holds the request until the opponent plays or the wait runs out
+    auto clientIndex = StateManager::getInstance()->getGameState()->clientPlayer->getIndex();
+    RequestScheduler::Options options;
+    options.timeout = LONG_POLL_SECONDS + 5.f;  // Leave the server time to answer an expired wait
+    options.owner   = this;
+    RequestScheduler::getInstance()->get(
+        "/play/" + std::to_string(clientIndex) + "?wait=" + std::to_string(LONG_POLL_SECONDS),
+        [this](const RequestScheduler::Response& response) {
+        _isLongPolling = false;
+        auto code      = response.code;
+        int cardIndex;
+        if (code == 200 && body::parseInt(response.body, cardIndex))
+        {
+            onOpponentPlayed(cardIndex);
+        }
+        if (!_waitingForOpponent || SocketNetworkManager::getInstance()->isConnected())
+            return;
+        if (code == 200 || code == 400)
+        {
+            longPollOpponentMove();  // Stale answer or the wait ran out, ask again straight away
+        }
+        else
+        {
+            AXLOG("Long poll failed, response code: %d, retrying in 5s...", code);
+            this->scheduleOnce([this](float dt) { longPollOpponentMove(); }, 5.0f, "retry_check_turn");
+        }
+    }, options);
+}
+
+void MainGameCommand::onCardPlayedMessage(const SocketMessage& message)
+{
+    // A malformed push is dropped like a frame that does not parse, value() would throw on it
+    const auto& data = message.getData();
+    auto played      = data.find("data");
+    if (played == data.end() || !played->is_object())
+        return;
+    auto playerId = played->find("player_id");
+    auto cardId   = played->find("card_id");
+    if (playerId == played->end() || !playerId->is_number_integer() || cardId == played->end() ||
+        !cardId->is_number_integer())
+        return;
+    if (playerId->get<int>() == StateManager::getInstance()->getGameState()->clientPlayer->getIndex())
+        return;  // Our own move echoed back
+    onOpponentPlayed(cardId->get<int>());
+}
+
+void MainGameCommand::onMoveMessage(const SocketMessage& message)
+{
+    wire::MoveMessage move;
+    if (!wire::decodeMove(message.getPayload(), move))
+        return;
+    if (move.playerId == StateManager::getInstance()->getGameState()->clientPlayer->getIndex())
+        return;  // Our own move echoed back
+    onOpponentPlayed(move.cardId);
+}
+
+void MainGameCommand::onWebSocketClosed(EventWebSocket* event)
+{
+    // No more pushes, fall back to long polling until the turn arrives
+    if (_waitingForOpponent)
+        longPollOpponentMove();
+}
+
+void MainGameCommand::catchUp()
+{
+    auto& table = StateManager::getInstance()->getGameState()->table;
+    RequestScheduler::Options options;
+    options.retries = 2;
+    options.owner   = this;
+    RequestScheduler::getInstance()->get(
+        "/state?since=" + std::to_string(table.getVersion()), [this](const RequestScheduler::Response& response) {
+        auto& table = StateManager::getInstance()->getGameState()->table;
+        wire::Header header;
+        std::span<const uint8_t> payload;
+        std::vector<int32_t> changedCards;
+        auto bytes = std::span(reinterpret_cast<const uint8_t*>(response.body.data()), response.body.size());
+        bool isCaughtUp = response.code == 200 && wire::decodeFrame(bytes, header, payload) &&
+                          header.type == wire::MessageType::STATE_DELTA && table.apply(payload, &changedCards);
+        if (!isCaughtUp)
+        {
+            // Without the server's table an unanswered move may or may not have gone through, it stays
+            // pending until we can tell
+            AXLOG("State catch-up failed, response code: %d, retrying in 5s...", response.code);
+            this->scheduleOnce([this](float dt) { catchUp(); }, 5.0f, "retry_catch_up");
+            return;
+        }
+
+        // Unanswered own moves went through if the server has their card on the field
+        auto moves = _pendingMoves;  // Both change _pendingMoves
+        for (auto move : moves)
+        {
+            if (_pendingMoves.getIndex(move) == -1 || move->getOutcome() != PlayCardCommand::Outcome::UNCONFIRMED)
+                continue;
+            if (table.getCard(move->getCard()->getId()).zoneIndex == TableState::PLAY_FIELD_ZONE)
+                acceptMove(move);
             else
-            {
-                AXLOG("Opponent hasn't played yet, retrying in 5s... response code: %d", response->getResponseCode());
-
-                this->scheduleOnce([this](float dt) {
-                    HttpRequestHandler::sendGetRequest(
-                        "/play/" +
-                            std::to_string(StateManager::getInstance()->getGameState()->clientPlayer->getIndex()),
-                        [this](HttpClient* client, HttpResponse* response) {
-                            setCurrentPlayerIndex(_currentPlayerIndex);
-                        });
-                }, 5.0f, "retry_check_turn");
-            }
-        };
-        
-        HttpRequestHandler::sendGetRequest(
-            "/play/" + std::to_string(gameState->clientPlayer->getIndex()), callable);
-        
+                rollBack(move);
+        }
+
+        // Only the play field can have moved behind our back, the hands change by playing from them
+        for (auto cardId : changedCards)
+            if (table.getCard(cardId).zoneIndex == TableState::PLAY_FIELD_ZONE)
+                onOpponentPlayed(cardId);
+    }, options);
+}
+
+void MainGameCommand::onMoveOutcome(PlayCardCommand* move)
+{
+    if (_pendingMoves.getIndex(move) == -1)
+        return;  // Already rolled back with an earlier move
+    switch (move->getOutcome())
+    {
+    case PlayCardCommand::Outcome::ACCEPTED:
+        acceptMove(move);
+        break;
+    case PlayCardCommand::Outcome::REJECTED:
+        rollBack(move);
+        break;
+    default:
+        catchUp();  // The server's table tells whether the move went through
+        break;
     }
 }
+
+void MainGameCommand::acceptMove(PlayCardCommand* move)
+{
+    if (auto replayLog = StateManager::getInstance()->getGameState()->replayLog)
+        replayLog->recordMove(move->getPlayerIndex(), move->getCard()->getId());
+    auto playerIndex = move->getPlayerIndex();
+    dropMove(move);
+    if (_isAwaitingWin && _pendingMoves.empty())
+    {
+        AXLOG("%d win", playerIndex);
+        setDone(true);
+    }
+}
+
+void MainGameCommand::rollBack(PlayCardCommand* move)
+{
+    auto index = _pendingMoves.getIndex(move);
+    if (index == -1)
+        return;
+    AXLOG("Move %u refused, rolling back", move->getMoveId());
+
+    // Moves after a refused one are refused too. Newest first, so each card goes back to the slot it left;
+    // each move reverts its own history step, opponent moves committed in between stay.
+    auto playerIndex = move->getPlayerIndex();
+    while (_pendingMoves.size() > index)
+    {
+        auto undone = _pendingMoves.back();
+        undone->undo();
+        _playerList[undone->getPlayerIndex()].push_back(undone->getCard());
+        dropMove(undone);
+    }
+
+    // Back to the turn of the refused move, whatever we were waiting for since no longer counts
+    _isAwaitingWin      = false;
+    _waitingForOpponent = false;
+    for (auto input : _playerList[1 - playerIndex])
+        input->lockInput();
+    setCurrentPlayerIndex(playerIndex);
+}
+
+void MainGameCommand::dropMove(PlayCardCommand* move)
+{
+    // Freed at the end of the frame rather than inside the answer that settled it
+    move->retain();
+    move->autorelease();
+    _pendingMoves.eraseObject(move);
+}
+
+void MainGameCommand::onOpponentPlayed(int cardIndex)
+{
+    if (!_waitingForOpponent)
+        return;  // Push and check both delivered the same move
+
+    Card* playedCard = StateManager::getInstance()->getGameState()->getCard(cardIndex);
+    if (!playedCard || playedCard->getCurrentZone() == _playField)
+        return;  // Unknown or already on the field, e.g. the previous move answered before ours reached the server
+
+    _waitingForOpponent = false;
+    auto gameState      = StateManager::getInstance()->getGameState();
+    if (auto replayLog = gameState->replayLog)
+        replayLog->recordMove(_currentPlayerIndex, cardIndex);
+    gameState->history.setCard(cardIndex, {TableState::PLAY_FIELD_ZONE,
+                                           gameState->playTable.countInZone(TableState::PLAY_FIELD_ZONE),
+                                           _currentPlayerIndex, playedCard->getFaceUp()});
+    gameState->history.commit();
+    playedCard->moveToZone(_playField);
+    AXLOG("Opponent played card %d, current player index: %d", cardIndex, _currentPlayerIndex);
+    for (auto input : _playerList[_currentPlayerIndex])
+    {
+        input->lockInput();
+    }
+    _playerList[_currentPlayerIndex].erase(
+        std::remove(_playerList[_currentPlayerIndex].begin(), _playerList[_currentPlayerIndex].end(), playedCard),
+        _playerList[_currentPlayerIndex].end());
+    if (_playerList[_currentPlayerIndex].size() == 1)
+    {
+        AXLOG("%d win", _currentPlayerIndex);
+        setDone(true);
+        return;
+    }
+    setCurrentPlayerIndex(1 - _currentPlayerIndex);
+}
+
+MainGameCommand::~MainGameCommand()
+{
+    _eventDispatcher->removeEventListener(_socketListener);
+}
@@ -4,23 +4,53 @@
 
 #include "core/object/Zone.h"
 #include "core/rule/Command.h"
+#include "core/rule/command/PlayCardCommand.h"
 #include "core/interface/ILockableInput.h"
 #include "core/event/EventListenerZone.h"
+#include "core/event/EventListenerWebSocket.h"
+#include "core/network/SocketMessage.h"
 
 class MainGameCommand : public Command
 {
 public:
     MainGameCommand(Zone* playField);
-    virtual ~MainGameCommand() {};
+    virtual ~MainGameCommand();
     void execute() override;
     void update(float delta) override;
     void onMainFieldCardReceived(EventZone* event);
     void setCurrentPlayerIndex(int index);
 
+    // Opponent moves arrive as "card_played" or binary MOVE pushes on the WebSocket, long polling
+    // covers a closed socket
+    void onCardPlayedMessage(const SocketMessage& message);
+    void onMoveMessage(const SocketMessage& message);
+    void onWebSocketClosed(EventWebSocket* event);
+    // Fetch what changed on the server's table since our copy and apply it, e.g. after reconnecting.
+    // Also settles own moves the server never answered for, and retries until the table is fetched.
+    void catchUp();
+
 protected:
+    static constexpr int LONG_POLL_SECONDS = 25;
+
+    void waitForOpponent();
+    void longPollOpponentMove();
+    void onOpponentPlayed(int cardIndex);
+
+    // Own moves are shown at once and settled when the server answers
+    void onMoveOutcome(PlayCardCommand* move);
+    void acceptMove(PlayCardCommand* move);
+    void rollBack(PlayCardCommand* move);  // Undoes move and every move made after it
+    void dropMove(PlayCardCommand* move);
+
     std::vector<std::vector<ILockableInput*>> _playerList = std::vector<std::vector<ILockableInput*>>(2);
     EventListenerZone* _zoneListener = nullptr;
     Zone* _playField                 = nullptr;  // The main play field zone
     int _currentPlayerIndex          = 1;        // Index to track the current player
     bool _firstTime                                       = true;
+    EventListenerWebSocket* _socketListener = nullptr;
+    bool _waitingForOpponent                = false;
+    bool _isLongPolling                     = false;
+    ax::Vector<PlayCardCommand*> _pendingMoves;  // Oldest first
+    unsigned int _lastMoveId = 0;
+    bool _isAwaitingWin      = false;  // Our last card is down, the win counts once the server has it
 };
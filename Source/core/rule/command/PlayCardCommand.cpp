@@ -0,0 +1,50 @@
+#include "PlayCardCommand.h"
+#include "core/network/RequestScheduler.h"
+#include "core/model/StateManager.h"
+
+PlayCardCommand::PlayCardCommand(unsigned int moveId, Card* card, int playerIndex, OutcomeCallback onOutcome)
+    : _moveId(moveId), _card(card), _playerIndex(playerIndex), _onOutcome(std::move(onOutcome))
+{
+    _hand      = card->getCurrentZone();
+    _handIndex = _hand ? _hand->getCardList().getIndex(card) : -1;
+}
+
+void PlayCardCommand::execute()
+{
+    setRunning(true);
+
+    // Our table takes the move now as one step, undo takes that step back even with opponent moves after it
+    auto gameState = StateManager::getInstance()->getGameState();
+    gameState->history.setCard(_card->getId(), {TableState::PLAY_FIELD_ZONE,
+                                                gameState->playTable.countInZone(TableState::PLAY_FIELD_ZONE),
+                                                _playerIndex, _card->getFaceUp()});
+    _stepId = gameState->history.commit();
+
+    // Batchable so it shares a round trip with the opponent check that follows when the turn passes.
+    // Retrying is safe, the server accepts a repeat of the last move again.
+    RequestScheduler::Options options;
+    options.retries   = 2;
+    options.owner     = this;
+    options.batchable = true;
+    RequestScheduler::getInstance()->post(
+        "/play/" + std::to_string(_playerIndex) + "/" + std::to_string(_card->getId()), "",
+        [this](const RequestScheduler::Response& response) {
+        if (response.succeeded())
+            _outcome = Outcome::ACCEPTED;
+        else if (response.code == 409)
+            _outcome = Outcome::REJECTED;
+        else
+            _outcome = Outcome::UNCONFIRMED;
+        AXLOG("Move %u: card %d, response code: %d", _moveId, _card->getId(), response.code);
+        setDone(true);
+        if (_onOutcome)
+            _onOutcome(this);
+    }, options);
+}
+
+void PlayCardCommand::undo()
+{
+    StateManager::getInstance()->getGameState()->history.revert(_stepId);
+    if (_hand)
+        _hand->moveCardToThisZone(_card, 0.3f, _handIndex);
+}
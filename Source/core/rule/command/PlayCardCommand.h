@@ -0,0 +1,42 @@
+#pragma once
+
+#include "axmol.h"
+#include "core/object/Card.h"
+#include "core/object/Zone.h"
+#include "core/rule/Command.h"
+
+// One of the client's own moves, shown straight away and confirmed by the server afterwards.
+// Made while the card is still in its hand: execute plays it on GameState::playTable as one
+// history step and sends the move, undo reverts that step and puts the card in the same slot.
+// The move id tags the move so a late answer finds it among the pending ones.
+class PlayCardCommand : public Command
+{
+public:
+    enum class Outcome
+    {
+        PENDING,
+        ACCEPTED,
+        REJECTED,     // The server refused the move, roll it back
+        UNCONFIRMED,  // No answer after the retries, the server may or may not have it
+    };
+    using OutcomeCallback = std::function<void(PlayCardCommand* move)>;
+
+    PlayCardCommand(unsigned int moveId, Card* card, int playerIndex, OutcomeCallback onOutcome);
+    void execute() override;
+    void undo() override;
+
+    unsigned int getMoveId() const { return _moveId; }
+    Card* getCard() const { return _card; }
+    int getPlayerIndex() const { return _playerIndex; }
+    Outcome getOutcome() const { return _outcome; }
+
+protected:
+    unsigned int _moveId;
+    Card* _card;
+    Zone* _hand;
+    ssize_t _handIndex;
+    int _playerIndex;
+    uint32_t _stepId = 0;  // The move's step in GameState::history
+    Outcome _outcome = Outcome::PENDING;
+    OutcomeCallback _onOutcome;
+};
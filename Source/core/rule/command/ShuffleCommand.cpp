@@ -1,11 +1,9 @@
 #include "ShuffleCommand.h"
-#include "utils/random.hpp"
 #include "core/scene/GameScene.h"
 #include "core/model/StateManager.h"
 
-#include "core/network/HttpRequestHandler.h"
-
-using Random = lib::random_static;
+#include "core/network/RequestScheduler.h"
+#include "core/network/protocol/BodyParser.h"
 
 ShuffleCommand::ShuffleCommand(ax::Vector<Card*> &cards) : _cardsToShuffle(cards) {
     this->scheduleUpdate();
@@ -17,26 +15,37 @@ void ShuffleCommand::execute()
     setRunning(true);
     auto& gameCards = StateManager::getInstance()->getGameState()->cards;
 
-    HttpRequestHandler::sendGetRequest("/shuffle/" + std::to_string(gameCards.size()),
-                                                            [this, &gameCards](HttpClient* client, HttpResponse* response) {
-        if (response->getResponseCode() == 200)
+    // Only the seed crosses the network, the server derives the same order from it. The count has
+    // the server deal its copy of the deck, which it checks every play against.
+    RequestScheduler::Options options;
+    options.timeout = 5.f;
+    options.retries = 2;
+    options.owner   = this;
+    auto path       = "/seed?count=" + std::to_string(gameCards.size());
+    RequestScheduler::getInstance()->get(path, [this, &gameCards](const RequestScheduler::Response& response) {
+        auto& random = StateManager::getInstance()->getGameState()->random;
+        uint64_t seed;
+        if (response.code == 200 && body::parseUInt64(response.body, seed))
         {
-            std::vector<int> shuffledIndices = HttpRequestHandler::convertBufferToVectorOfInt(response->getResponseData());
-            std::vector<Card*> shuffledCards(gameCards.size());
-            for (size_t i = 0; i < shuffledIndices.size(); ++i)
-                shuffledCards[i] = gameCards.at(shuffledIndices[i]);
-            gameCards.clear();
-            for (auto card : shuffledCards)
-                gameCards.pushBack(card);
+            random.seed(seed);
         }
         else
         {
-            std::vector<Card*> cardsVector(gameCards.begin(), gameCards.end());
-            Random::shuffle(cardsVector.begin(), cardsVector.end());
-            gameCards.clear();
-            for (auto card : cardsVector)
-                gameCards.pushBack(card);
+            // Server unreachable, play on with a local game the server will not agree with
+            random.seed(GameRandom::makeSeed());
+            AXLOG("No seed from the server, shuffling locally");
         }
+
+        if (auto replayLog = StateManager::getInstance()->getGameState()->replayLog)
+            replayLog->recordSeed(random.getSeed());
+
+        auto order = random.shuffleOrder(int(gameCards.size()));
+        std::vector<Card*> shuffledCards(gameCards.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            shuffledCards[i] = gameCards.at(order[i]);
+        gameCards.clear();
+        for (auto card : shuffledCards)
+            gameCards.pushBack(card);
         this->setDone(true);
-    });
+    }, options);
 }
@@ -3,17 +3,65 @@
 #include "core/rule/command/ShuffleCommand.h"
 #include "core/rule/command/MainGameCommand.h"
 
+#include "core/object/CardAtlas.h"
+#include "core/event/EventCard.h"
+#include "core/event/EventZone.h"
+#include "core/object/data/DeckTextParser.h"
 #include "core/view/View.h"
 #include "core/view/Player.h"
 #include "core/model/StateManager.h"
 
 #include "core/network/HttpRequestHandler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
 
 using namespace ax;
 using namespace ax::network;
 using namespace std;
 
+namespace
+{
+// Applies replayed records to the scene's cards, each move lands on the next frame
+class SceneReplayTarget : public ReplayTarget
+{
+public:
+    explicit SceneReplayTarget(GameState* gameState) : _gameState(gameState) {}
+
+    void onSeed(uint64_t seed) override { _gameState->random.seed(seed); }
+    void onDeal(int32_t cardId, int32_t zoneIndex) override { moveCard(cardId, zoneIndex); }
+    void onMove(int32_t playerId, int32_t cardId) override { moveCard(cardId, Replayer::PLAY_FIELD_ZONE); }
+
+private:
+    Card* moveCard(int32_t cardId, int32_t zoneIndex)
+    {
+        auto card = _gameState->getCard(cardId);
+        if (!card || zoneIndex < 0 || zoneIndex >= int32_t(_gameState->zones.size()))
+            return nullptr;
+        card->moveToZone(_gameState->zones.at(zoneIndex), 0.f);
+        return card;
+    }
+
+    GameState* _gameState;
+};
+
+// Each sprite the deck's records use once, in record order
+template <typename GetSprite>
+std::vector<std::string> collectSprites(const DeckFile& deck, GetSprite getSprite)
+{
+    std::vector<std::string> paths;
+    for (const auto& record : deck.getCards())
+    {
+        auto path = getSprite(record);
+        if (std::find(paths.begin(), paths.end(), path) == paths.end())
+            paths.emplace_back(path);
+    }
+    return paths;
+}
+}  // namespace
+
 GameScene* GameScene::create()
 {
     GameScene* gameScene = new (std::nothrow) GameScene();
@@ -55,8 +103,10 @@ bool GameScene::init()
     StateManager::getInstance()->setGameState(new GameState());
     _gameState = StateManager::getInstance()->getGameState();
 
+    CardAtlas::loadIndex(getAtlasIndexPath());
 
-    setUpObjects();
+    _inputRouter = InputRouter::create();
+    this->addChild(_inputRouter);
 
     // scheduleUpdate() is required to ensure update(float) is called on every loop
     scheduleUpdate();
@@ -64,7 +114,11 @@ bool GameScene::init()
     return true;
 }
 
-void GameScene::update(float delta) {}
+void GameScene::update(float delta)
+{
+    if (!_logicEngine.isIdle())
+        _logicEngine.step();
+}
 
 void GameScene::setUpObjects() {
     Zone* zone = Zone::create(new ZoneData());
@@ -83,24 +137,122 @@ void GameScene::setUpObjects() {
     zone3->setPosition(Vec2(visibleSize.width / 2 + origin.x, visibleSize.height / 2 + origin.y));
     zone3->setContentSize(Size(300, 300));
 
-    _gameState->zones.pushBack(zone);
-    _gameState->zones.pushBack(zone2);
-    _gameState->zones.pushBack(zone3);
+    _gameState->addZone(zone);
+    _gameState->addZone(zone2);
+    _gameState->addZone(zone3);
+    for (auto z : _gameState->zones)
+        _inputRouter->addZone(z);
 
-    // Set up 8 cards 4 for each side
+    if (!_deckPath.empty() && loadDeck(_deckPath, _deck))
+    {
+        setUpDeckCards();
+        return;
+    }
+
+    // Set up 8 cards 4 for each side, face down like a deck so no front is loaded before a flip
+    auto frontImagePaths = getFrontImagePaths();
+    auto backImagePath   = getBackImagePaths().front();
+    for (int id = 0; id < frontImagePaths.size(); ++id)
+    {
+        Card* card = Card::create(new CardData(frontImagePaths[id], backImagePath, false));
+        this->addChild(card);
+        card->setPosition(Vec2(visibleSize.width / 2 + origin.x, visibleSize.height / 2 + origin.y));
+        card->setContentSize(Size(100, 150));
+        card->setId(id);
+        _gameState->addCard(card);
+        _inputRouter->addCard(card);
+        card->setName(std::filesystem::path(frontImagePaths[id]).stem().string());
+    }
+
+}
+
+bool GameScene::loadDeck(const std::string& path, DeckFile& deck)
+{
+    // Text configs still work while editing a deck, they are parsed into the same layout
+    if (path.ends_with(".txt"))
+    {
+        DeckTextParser parser;
+        if (!FileUtils::getInstance()->isFileExist(path))
+        {
+            AXLOG("Failed to read deck config {}", path);
+            return false;
+        }
+        if (!parser.parse(FileUtils::getInstance()->getStringFromFile(path)))
+        {
+            AXLOG("Invalid deck config {}:{}", path, parser.getErrorText());
+            return false;
+        }
+        return deck.load(parser.build());
+    }
+
+    std::vector<uint8_t> bytes;
+    if (FileUtils::getInstance()->getContents(path, &bytes) != FileUtils::Status::OK)
+        AXLOG("Failed to read deck {}", path);
+    else if (!deck.load(std::move(bytes)))
+        AXLOG("Invalid deck {}: {}", path, deck.getError());
+    else
+        return true;
+    return loadDeck(std::filesystem::path(path).replace_extension(".txt").generic_string(), deck);
+}
+
+void GameScene::setUpDeckCards()
+{
+    // Records are read straight from the deck bytes, every copy of a record becomes its own card. Cards
+    // start face down, their fronts load on the first flip.
     int id = 0;
-    for (auto i : {"0", "1"})
-        for (auto color : {"blue", "red", "green", "yellow"})
+    for (const auto& record : _deck.getCards())
+    {
+        auto frontImagePath = _deck.getFrontSprite(record);
+        auto backImagePath  = _deck.getBackSprite(record);
+        auto name           = std::filesystem::path(frontImagePath).stem().string();
+        for (uint32_t copy = 0; copy < record.amount; ++copy)
         {
-            Card* card = Card::create(new CardData("card/uno/" + string(i) + "_" + color + ".png", "card/Card Back 1.png"));
+            auto data            = new CardData();
+            data->frontImagePath = frontImagePath;
+            data->backImagePath  = backImagePath;
+            data->isFaceUp       = false;
+            Card* card           = Card::create(data);
+            if (!card)
+                continue;
             this->addChild(card);
-            card->setPosition(Vec2(visibleSize.width / 2 + origin.x, visibleSize.height / 2 + origin.y));
-            card->setContentSize(Size(100, 150));
-            _gameState->cards.pushBack(card);
-            card->setName(string(color) + string(i));
+            card->setPosition(Vec2(record.posX, record.posY));
+            card->setContentSize(Size(record.sizeX, record.sizeY));
+            card->setRotation(record.rotation);
             card->setId(id++);
+            _gameState->addCard(card);
+            _inputRouter->addCard(card);
+            card->setName(name);
         }
+    }
+}
+
+std::vector<std::string> GameScene::getFrontImagePaths()
+{
+    std::vector<std::string> paths;
+    DeckFile deck;
+    if (!_deckPath.empty() && loadDeck(_deckPath, deck))
+        return collectSprites(deck, [&deck](const DeckCardRecord& record) { return deck.getFrontSprite(record); });
+
+    for (auto i : {"0", "1"})
+        for (auto color : {"blue", "red", "green", "yellow"})
+            paths.push_back("card/uno/" + string(i) + "_" + color + ".png");
+    return paths;
+}
 
+std::vector<std::string> GameScene::getBackImagePaths()
+{
+    DeckFile deck;
+    if (!_deckPath.empty() && loadDeck(_deckPath, deck))
+        return collectSprites(deck, [&deck](const DeckCardRecord& record) { return deck.getBackSprite(record); });
+    return {"card/Card Back 1.png"};
+}
+
+std::string GameScene::getAtlasIndexPath()
+{
+    // pack_atlas.py names a deck's sheets after its config, the demo's are "uno"
+    if (_deckPath.empty())
+        return "card/atlas/uno.txt";
+    return "card/atlas/" + std::filesystem::path(_deckPath).stem().generic_string() + ".txt";
 }
 
 void GameScene::setUpRule() {
@@ -114,6 +266,13 @@ void GameScene::setUpRule() {
         _gameState->zones[i]->lockInput();
     }
 
+    auto replayFolder = FileUtils::getInstance()->getWritablePath() + "replays/";
+    FileUtils::getInstance()->createDirectory(replayFolder);
+    auto startTime =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch());
+    if (_replayLog.open(replayFolder + std::to_string(startTime.count()) + ".replay"))
+        _gameState->replayLog = &_replayLog;
+
     Command* shuffleCommand = new ShuffleCommand(_gameState->cards);
     Command* dealCommand    = new DealCommand(_gameState->cards, _gameState->zones);
     Command* mainGameCommand = new MainGameCommand(_gameState->zones[2]);
@@ -128,6 +287,8 @@ void GameScene::setUpRule() {
     this->addChild(shuffleLogic);
     this->addChild(dealLogic);
     this->addChild(mainLogic);
+    for (auto flow : _flows)
+        _logicEngine.add(flow);
     shuffleLogic->start();
 
     //std::vector<Command*> commands{shuffleCommand, dealCommand};
@@ -180,6 +341,10 @@ void GameScene::onKeyReleased(EventKeyboard::KeyCode code, Event* event) {}
 
 void GameScene::onEnter() {
     Scene::onEnter();
+    // Cards are created on entry rather than in init, the lobby preloads their textures in between
+    if (_gameState->cards.empty())
+        setUpObjects();
+
     Player* player           = new Player("Test", 0);
     _gameState->clientPlayer = player;
 
@@ -204,4 +369,28 @@ void GameScene::onEnter() {
     });
 }
 
-GameScene::~GameScene() {}
+bool GameScene::playReplay(const std::string& path)
+{
+    Replayer replayer;
+    SceneReplayTarget target(_gameState);
+    if (!replayer.load(FileUtils::getInstance()->fullPathForFilename(path)) || !replayer.run(&target))
+    {
+        AXLOG("Replay {} stopped early: {}", path, replayer.getError());
+        return false;
+    }
+    AXLOG("Replayed {} moves, winner {}", replayer.getSummary().moves.size(), replayer.getSummary().winner);
+    return true;
+}
+
+GameScene::~GameScene()
+{
+    _logicEngine.clear();
+    if (_gameState->replayLog == &_replayLog)
+        _gameState->replayLog = nullptr;
+    _replayLog.close();
+
+    // Custom events only live for one dispatch, a non-zero count here is a leak (debug builds only)
+    AXLOGD("Card events dispatched: {}, zone events dispatched: {}", EventCard::getCreatedCount(),
+           EventZone::getCreatedCount());
+    AXASSERT(EventCard::getLiveCount() == 0 && EventZone::getLiveCount() == 0, "Leaked custom events");
+}
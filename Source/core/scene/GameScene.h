@@ -4,11 +4,15 @@
 
 #include "core/object/Card.h"
 #include "core/object/Zone.h"
+#include "core/object/InputRouter.h"
 #include "core/event/EventListenerZone.h"
 
 #include "core/rule/Rule.h"
 #include "core/rule/LogicUnit.h"
+#include "core/logic/LogicEngine.h"
+#include "core/logic/Replayer.h"
 #include "core/model/GameState.h"
+#include "core/object/data/DeckFile.h"
 
 
 class GameScene : public ax::Scene
@@ -21,7 +25,20 @@ public:
     void update(float delta) override;
 
     void setUpObjects();
+    static constexpr const char* ASCENSION_DECK_PATH = "configs/ascension.deck";  // Shipped deck, see compile_deck.py
+
+    // Deck the next game scene deals: a compiled .deck (see Content/configs/compile_deck.py) or a text .txt
+    // config. Empty, the default, deals the 8 card UNO demo.
+    static void setDeckPath(const std::string& path) { _deckPath = path; }
+    static const std::string& getDeckPath() { return _deckPath; }
     void setUpRule();
+    // Puts the cards where a recorded game had them, no rules, network or animation. Call after setUpObjects.
+    bool playReplay(const std::string& path);
+
+    // Card faces and atlas index of the deck setUpObjects deals, so another scene can preload them
+    static std::vector<std::string> getFrontImagePaths();
+    static std::vector<std::string> getBackImagePaths();
+    static std::string getAtlasIndexPath();
 
     // mouse
     bool onMouseDown(ax::Event* event);
@@ -42,12 +59,19 @@ public:
     ~GameScene() override;
 
 protected:
+    // A .deck from an older compile_deck.py is rejected, the text config next to it still loads
+    static bool loadDeck(const std::string& path, DeckFile& deck);
+    void setUpDeckCards();
+
+    static inline std::string _deckPath;
+
     ax::EventListenerKeyboard* _keyboardListener = nullptr;
     ax::EventListenerMouse* _mouseListener       = nullptr;
     int _sceneID                                 = 0;
 
     Rule* _rule = nullptr;
     std::vector<LogicUnit*> _flows;
+    LogicEngine _logicEngine;  // Ticks flows only when a command completes or watched state changes
 
     ax::Vec2 visibleSize = _director->getVisibleSize();
     ax::Vec2 origin      = _director->getVisibleOrigin();
@@ -55,6 +79,9 @@ protected:
     ax::Vec2 safeOrigin  = safeArea.origin;
 
     GameState* _gameState = nullptr; 
+    InputRouter* _inputRouter = nullptr;  // Routes table mouse input to cards and zones
+    DeckFile _deck;
+    ReplayWriter _replayLog;  // Records this game to the writable path's replays folder
 
     //EventListenerZone* _cardEventListener = nullptr;
 };
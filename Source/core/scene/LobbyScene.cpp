@@ -3,6 +3,8 @@
 #include "core/model/StateManager.h"
 
 #include "core/event/EventWebSocket.h"
+
+#include "core/network/MessageRouter.h"
 #include "core/network/SocketNetworkManager.h"
 
 #include "ui/UIButton.h"
@@ -11,6 +13,8 @@
 #include "utils/json.hpp"
 
 #include "core/scene/MenuScene.h"
+#include "core/scene/GameScene.h"
+#include "core/object/CardAtlas.h"
 
 using namespace ax;
 using namespace ax::ui;
@@ -41,12 +45,17 @@ bool LobbyScene::init()
     _keyboardListener->onKeyReleased = AX_CALLBACK_2(LobbyScene::onKeyReleased, this);
     _eventDispatcher->addEventListenerWithFixedPriority(_keyboardListener, 11);
 
-    _websocketListener                     = EventListenerWebSocket::create();
-    _websocketListener->onWebSocketMessage = AX_CALLBACK_1(LobbyScene::onWebSocketMessage, this);
-    _websocketListener->onWebSocketOpen    = [](EventWebSocket* event) {};
-    _websocketListener->onWebSocketError   = [](EventWebSocket* event) {};
-    _websocketListener->onWebSocketClose   = [](EventWebSocket* event) {};
-    _eventDispatcher->addEventListenerWithFixedPriority(_websocketListener, 11);
+    auto router = MessageRouter::getInstance();
+    router->on(SocketCommand::LIST_USERS_IN_ROOM, this, AX_CALLBACK_1(LobbyScene::onUserListMessage, this));
+    router->on(SocketCommand::USER_JOINED, this, AX_CALLBACK_1(LobbyScene::onUserJoinedMessage, this));
+    router->on(SocketCommand::USER_LEFT, this, AX_CALLBACK_1(LobbyScene::onUserLeftMessage, this));
+
+    _socketListener                    = EventListenerWebSocket::create();
+    _socketListener->onWebSocketOpen   = [](EventWebSocket*) {};
+    _socketListener->onWebSocketError  = [](EventWebSocket*) {};
+    _socketListener->onWebSocketClose  = [](EventWebSocket*) {};
+    _socketListener->onWebSocketResync = [this](EventWebSocket*) { requestUserList(); };
+    _eventDispatcher->addEventListenerWithFixedPriority(_socketListener, 11);
     scheduleUpdate();
 
     _roomIdText =
@@ -55,13 +64,9 @@ bool LobbyScene::init()
     _roomIdText->setTextColor(Color4B::WHITE);
     this->addChild(_roomIdText);
 
-    SocketNetworkManager::getInstance()->sendMessage(json{{"type", "request"},
-                                                          {"command", "list_users_in_room"},
-                                                          {"data", json::object()},
-                                                          {"id", 0},
-                                                          {"time_stamp", 0}});
+    requestUserList();
 
-    auto _joinGameButton = Button::create("background.png");
+    _joinGameButton = Button::create("background.png");
     _joinGameButton->ignoreContentAdaptWithSize(false);
     _joinGameButton->setContentSize(Size(150, 50));
     _joinGameButton->setPosition(Vec2(visibleSize.width / 2, visibleSize.height / 2 - 100));
@@ -71,9 +76,32 @@ bool LobbyScene::init()
     });
     this->addChild(_joinGameButton);
 
+    _loadingText = Label::createWithSystemFont("Loading cards 0%", "Arial", 20);
+    _loadingText->setPosition(Vec2(visibleSize.width / 2, visibleSize.height / 2 - 150));
+    _loadingText->setTextColor(Color4B::WHITE);
+    this->addChild(_loadingText);
+
+    preloadCards();
+
     return true;
 }
 
+void LobbyScene::preloadCards()
+{
+    _joinGameButton->setEnabled(false);
+    // The faces of the deck the game scene will deal, see GameScene::setDeckPath
+    CardAtlas::loadIndex(GameScene::getAtlasIndexPath());
+    _cardPreloader.start(
+        GameScene::getFrontImagePaths(), GameScene::getBackImagePaths(),
+        [this](size_t loaded, size_t total) {
+        _loadingText->setString(std::format("Loading cards {}%", loaded * 100 / total));
+    },
+        [this]() {
+        _loadingText->setString("Cards loaded");
+        _joinGameButton->setEnabled(true);
+    });
+}
+
 bool LobbyScene::onMouseDown(Event* event)
 {
     EventMouse* e = static_cast<EventMouse*>(event);
@@ -99,49 +127,58 @@ void LobbyScene::onKeyPressed(EventKeyboard::KeyCode code, Event* event) {}
 
 void LobbyScene::onKeyReleased(EventKeyboard::KeyCode code, Event* event) {}
 
-void LobbyScene::onWebSocketMessage(EventWebSocket* event)
+void LobbyScene::requestUserList()
 {
-    json message   = event->getData();
-    string command = message["command"];
-    if (command == "list_users_in_room")
-    {
-        vector<string> users = message["data"]["user_list"].get<vector<string>>();
-        _usersInRoom.clear();
-        for (size_t i = 0; i < users.size(); ++i)
-        {
-            auto userText = Label::createWithSystemFont(users[i], "Arial", 24);
-            userText->setPosition(Vec2(visibleSize.width / 2, visibleSize.height / 2 + 50 - i * 30));
-            userText->setTextColor(Color4B::WHITE);
-            this->addChild(userText);
-            _usersInRoom.pushBack(userText);
-        }
-    }
-    else if (command == "user_joined")
+    SocketNetworkManager::getInstance()->sendMessage(json{{"type", "request"},
+                                                          {"command", "list_users_in_room"},
+                                                          {"data", json::object()},
+                                                          {"time_stamp", 0}});
+}
+
+void LobbyScene::onUserListMessage(const SocketMessage& message)
+{
+    const json& data = message.getData();
+    if (!data.contains("data") || !data["data"].contains("user_list"))
+        return;
+    vector<string> users = data["data"]["user_list"].get<vector<string>>();
+    for (auto& text : _usersInRoom)
+        text->removeFromParent();  // A resync lists everyone again
+    _usersInRoom.clear();
+    for (size_t i = 0; i < users.size(); ++i)
     {
-        string user   = message["data"]["username"];
-        auto userText = Label::createWithSystemFont(user, "Arial", 24);
-        userText->setPosition(Vec2(visibleSize.width / 2, visibleSize.height / 2 + 50 - _usersInRoom.size() * 30));
+        auto userText = Label::createWithSystemFont(users[i], "Arial", 24);
+        userText->setPosition(Vec2(visibleSize.width / 2, visibleSize.height / 2 + 50 - i * 30));
         userText->setTextColor(Color4B::WHITE);
         this->addChild(userText);
         _usersInRoom.pushBack(userText);
     }
-    else if (command == "user_left")
+}
+
+void LobbyScene::onUserJoinedMessage(const SocketMessage& message)
+{
+    const json& data = message.getData();
+    string user      = data.contains("data") ? data["data"].value("username", "") : "";
+    auto userText    = Label::createWithSystemFont(user, "Arial", 24);
+    userText->setPosition(Vec2(visibleSize.width / 2, visibleSize.height / 2 + 50 - _usersInRoom.size() * 30));
+    userText->setTextColor(Color4B::WHITE);
+    this->addChild(userText);
+    _usersInRoom.pushBack(userText);
+}
+
+void LobbyScene::onUserLeftMessage(const SocketMessage& message)
+{
+    // Both servers name the player "username", as in user_joined
+    const json& data = message.getData();
+    string user      = data.contains("data") ? data["data"].value("username", "") : "";
+    for (auto& text : _usersInRoom)
     {
-        string user = message["data"]["user"];
-        for (auto& text : _usersInRoom)
+        if (text->getString() == user)
         {
-            if (text->getString() == user)
-            {
-                text->removeFromParent();
-                _usersInRoom.eraseObject(text);
-                break;
-            }
+            text->removeFromParent();
+            _usersInRoom.eraseObject(text);
+            break;
         }
     }
-    else
-    {
-        AXLOGD("Received unknown WebSocket message command: {}", command);
-    }
 }
 
 void LobbyScene::onEnter()
@@ -152,4 +189,9 @@ void LobbyScene::onEnter()
 
 void LobbyScene::startSocket(string authToken) {}
 
-LobbyScene::~LobbyScene() {}
+LobbyScene::~LobbyScene()
+{
+    _cardPreloader.cancel();
+    MessageRouter::getInstance()->removeOwner(this);
+    _eventDispatcher->removeEventListener(_socketListener);
+}
@@ -3,7 +3,10 @@
 #include "axmol.h"
 
 #include "ui/UIText.h"
+#include "ui/UIButton.h"
 #include "core/event/EventListenerWebSocket.h"
+#include "core/network/SocketMessage.h"
+#include "core/object/CardTexturePreloader.h"
 
 class LobbyScene : public ax::Scene
 {
@@ -21,8 +24,11 @@ public:
     void onKeyPressed(ax::EventKeyboard::KeyCode code, ax::Event* event);
     void onKeyReleased(ax::EventKeyboard::KeyCode code, ax::Event* event);
 
-    // WebSocket
-    void onWebSocketMessage(EventWebSocket* event);
+    // WebSocket, routed by MessageRouter
+    void onUserListMessage(const SocketMessage& message);
+    void onUserJoinedMessage(const SocketMessage& message);
+    void onUserLeftMessage(const SocketMessage& message);
+    void requestUserList();  // Also sent again when the socket resyncs
 
     // a selector callback
     void menuCloseCallback(ax::Object* sender);
@@ -30,13 +36,14 @@ public:
     void onEnter() override;
 
     void startSocket(std::string authToken);
+    void preloadCards();
 
     ~LobbyScene() override;
 
 protected:
     ax::EventListenerKeyboard* _keyboardListener = nullptr;
     ax::EventListenerMouse* _mouseListener       = nullptr;
-    EventListenerWebSocket* _websocketListener   = nullptr;
+    EventListenerWebSocket* _socketListener      = nullptr;
     int _sceneID                                 = 0;
 
     ax::Vec2 visibleSize = _director->getVisibleSize();
@@ -46,4 +53,8 @@ protected:
 
     ax::Vector<ax::Label*> _usersInRoom;
     ax::Label* _roomIdText = nullptr;
+
+    ax::ui::Button* _joinGameButton = nullptr;  // Enabled once the game's card textures are warm
+    ax::Label* _loadingText         = nullptr;
+    CardTexturePreloader _cardPreloader;
 };
@@ -3,8 +3,8 @@
 #include <format>
 #include "utils/json.hpp"
 
-#include "core/event/EventListenerWebsocket.h"
-#include "core/event/EventWebsocket.h"
+#include "core/network/MessageRouter.h"
+#include "core/network/RequestScheduler.h"
 
 #include "core/model/StateManager.h"
 
@@ -30,12 +30,9 @@ bool RoomScene::init()
     safeArea    = _director->getSafeAreaRect();
     safeOrigin  = safeArea.origin;
 
-    _websocketListener = EventListenerWebSocket::create();
-    _websocketListener->onWebSocketMessage = AX_CALLBACK_1(RoomScene::onWebSocketMessage, this);
-    _websocketListener->onWebSocketOpen    = [](EventWebSocket* event) {};
-    _websocketListener->onWebSocketError   = [](EventWebSocket* event) {};
-    _websocketListener->onWebSocketClose   = [](EventWebSocket* event) {};
-    _eventDispatcher->addEventListenerWithFixedPriority(_websocketListener, 11);
+    auto router = MessageRouter::getInstance();
+    router->on(SocketCommand::CREATE_ROOM, this, AX_CALLBACK_1(RoomScene::onCreateRoomMessage, this));
+    router->on(SocketCommand::JOIN_ROOM, this, AX_CALLBACK_1(RoomScene::onJoinRoomMessage, this));
 
 
     _mouseListener              = EventListenerMouse::create();
@@ -61,7 +58,6 @@ bool RoomScene::init()
         json message;
         message["command"] = "create_room";
         message["type"] = "request";
-        message["id"] = 0;
         message["data"] = json::object();
         _socketManager->sendMessage(message);
     });
@@ -85,7 +81,6 @@ bool RoomScene::init()
         json message;
         message["command"]  = "join_room";
         message["type"] = "request";
-        message["id"]   = 0;
         message["data"] = {{"room_id", roomId}};
         _socketManager->sendMessage(message);
     });
@@ -122,30 +117,11 @@ void RoomScene::onKeyPressed(EventKeyboard::KeyCode code, Event* event) {}
 
 void RoomScene::onKeyReleased(EventKeyboard::KeyCode code, Event* event) {}
 
-void RoomScene::onWebSocketMessage(EventWebSocket* event) {
-    json data = event->getData();
-    string cmd = data["command"];
-
-    if (cmd == "create_room")
-    {
-        onCreateRoomMessage(event);
-    }
-    else if (cmd == "join_room")
-    {
-        onJoinRoomMessage(event);
-    }
-    else
-    {
-        AXLOGD("Received unknown WebSocket message: {}", cmd);
-
-    }
-}
-
-void RoomScene::onCreateRoomMessage(EventWebSocket* event)
+void RoomScene::onCreateRoomMessage(const SocketMessage& message)
 {
-    json data = event->getData();
+    const json& data = message.getData();
 
-    std::string roomId = data["data"]["room_id"];
+    std::string roomId = data.contains("data") ? data["data"].value("room_id", "") : "";
     if (roomId.empty())
     {
         AXLOGD("Received create room message, but room ID is missing");
@@ -154,14 +130,15 @@ void RoomScene::onCreateRoomMessage(EventWebSocket* event)
     AXLOGD("Received create room message, room ID: {}", roomId);
 
     StateManager::getInstance()->getGameState()->roomId = roomId;
+    RequestScheduler::getInstance()->setRoomId(roomId);
 
     _director->replaceScene(utils::createInstance<LobbyScene>());
     
 }
 
-void RoomScene::onJoinRoomMessage(EventWebSocket* event) {
-    json data = event->getData();
-    std::string roomId = data["data"]["room_id"];
+void RoomScene::onJoinRoomMessage(const SocketMessage& message) {
+    const json& data = message.getData();
+    std::string roomId = data.contains("data") ? data["data"].value("room_id", "") : "";
     if (roomId.empty())
     {
         AXLOGD("Received join room message, but room ID is missing");
@@ -170,6 +147,7 @@ void RoomScene::onJoinRoomMessage(EventWebSocket* event) {
     AXLOGD("Received join room message, room ID: {}", roomId);
 
     StateManager::getInstance()->getGameState()->roomId = roomId;
+    RequestScheduler::getInstance()->setRoomId(roomId);
 
     _director->replaceScene(utils::createInstance<LobbyScene>());
 }
@@ -185,6 +163,5 @@ RoomScene::~RoomScene() {
         _eventDispatcher->removeEventListener(_keyboardListener);
     if (_mouseListener)
         _eventDispatcher->removeEventListener(_mouseListener);
-    if (_websocketListener)
-        _eventDispatcher->removeEventListener(_websocketListener);
+    MessageRouter::getInstance()->removeOwner(this);
 }
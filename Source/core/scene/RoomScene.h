@@ -5,7 +5,7 @@
 #include "ui/UIButton.h"
 #include "ui/UIEditBox/UIEditBox.h"
 #include "core/network/SocketNetworkManager.h"
-#include "core/event/EventListenerWebsocket.h"
+#include "core/network/SocketMessage.h"
 
 class RoomScene : public ax::Scene
 {
@@ -26,11 +26,9 @@ public:
     void onKeyPressed(ax::EventKeyboard::KeyCode code, ax::Event* event);
     void onKeyReleased(ax::EventKeyboard::KeyCode code, ax::Event* event);
 
-    // WebSocket
-    void onWebSocketMessage(EventWebSocket* event);
-
-    void onCreateRoomMessage(EventWebSocket* event);
-    void onJoinRoomMessage(EventWebSocket* event);
+    // WebSocket, routed by MessageRouter
+    void onCreateRoomMessage(const SocketMessage& message);
+    void onJoinRoomMessage(const SocketMessage& message);
 
     // a selector callback
     void menuCloseCallback(ax::Object* sender);
@@ -40,7 +38,6 @@ public:
     ~RoomScene() override;
 
 protected:
-    EventListenerWebSocket* _websocketListener   = nullptr;
     ax::EventListenerKeyboard* _keyboardListener = nullptr;
     ax::EventListenerMouse* _mouseListener       = nullptr;
     int _sceneID                                 = 0;
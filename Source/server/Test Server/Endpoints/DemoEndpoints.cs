@@ -1,16 +1,35 @@
+using System.Net.WebSockets;
+using System.Text.Json;
+
+using Microsoft.AspNetCore.WebUtilities;
+
+using Test_Server.Handlers;
+using Test_Server.Models;
+using Test_Server.Services;
+
 namespace Test_Server.Endpoints;
 
 public static class DemoEndpoints
 {
+    // Largest deck a game deals, bigger counts are refused
+    private const int MaxCards = 1024;
+    private const int PlayFieldZone = 2;
+
     public static void MapEndpoints(IEndpointRouteBuilder routeBuilder)
     {
 
         var _gameLock = new object();
         var currentPlayerCount = 0;
         var list = new List<int>();
+        // Zone of each card by id: the owner's hand (0 or 1) until played, then PlayFieldZone
+        var cardZones = Array.Empty<int>();
+        // Clients shuffle with GameRandom from the current game's seed, /shuffle derives the same order
+        var seed = GameRandom.MakeSeed();
 
         var previousPlayedCardIndex = -1;
         var previousPlayerId = -1;
+        // Completed and replaced on every play, wakes the long polls waiting on GET /play/{playerId}
+        var moveSignal = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
 
         routeBuilder.MapGet("/", () =>
         {
@@ -25,62 +44,176 @@ public static class DemoEndpoints
             return index;
         });
 
-        routeBuilder.MapGet("/shuffle/{count:int}", (int count) =>
+        (int status, object body) Shuffle(int count)
         {
-            if (count <= 0) return new List<int>();
+            if (count <= 0) return (StatusCodes.Status200OK, new List<int>());
+            if (count > MaxCards) return (StatusCodes.Status400BadRequest, "Too many cards");
 
             List<int> currentList;
             lock (_gameLock)
             {
-                if (list.Count != count)
+                // Both players ask for the deck, only the first ask after a finished or abandoned game deals anew
+                if (list.Count != count || previousPlayerId != -1)
                 {
-                    var random = new Random();
-                    list = Enumerable.Range(0, count).OrderBy(_ => random.Next()).ToList();
+                    // Every game draws its own seed, a replayed seed would replay the deal
+                    if (list.Count > 0) seed = GameRandom.MakeSeed();
+                    list = new GameRandom(seed).ShuffleOrder(count);
+                    // Dealt alternately into the two hands, as DealCommand does
+                    cardZones = new int[count];
+                    for (var i = 0; i < count; i++) cardZones[list[i]] = i % 2;
+                    previousPlayedCardIndex = -1;
+                    previousPlayerId = -1;
                 }
                 currentList = list.ToList(); // Return a copy for thread safety
             }
 
             Console.WriteLine(string.Join(", ", currentList));
-            return currentList;
-        });
+            return (StatusCodes.Status200OK, currentList);
+        }
 
-        routeBuilder.MapPost("/play/{playerId:int}/{cardId:int}", (int playerId, int cardId) =>
+        async Task<(int status, object body)> Play(int playerId, int cardId, PlayerService playerService)
         {
             int playedCard;
+            TaskCompletionSource playedSignal;
             lock (_gameLock)
             {
-                if (cardId < 0 || cardId >= list.Count) return "Invalid index";
-                if (cardId == previousPlayedCardIndex) return "Card already played";
-                if (playerId == previousPlayerId) return "Not your turn";
+                // 409 tells the client to roll back the move it already showed
+                if (cardId < 0 || cardId >= list.Count) return (StatusCodes.Status409Conflict, "Invalid index");
+                // The same move retried after a lost answer, it already went through
+                if (cardId == previousPlayedCardIndex && playerId == previousPlayerId)
+                    return (StatusCodes.Status200OK, $"Player {playerId} played card: {list[cardId]}");
+                if (playerId == previousPlayerId) return (StatusCodes.Status409Conflict, "Not your turn");
+                if (cardZones[cardId] == PlayFieldZone) return (StatusCodes.Status409Conflict, "Card already played");
+                if (cardZones[cardId] != playerId) return (StatusCodes.Status409Conflict, "Not your card");
 
                 previousPlayedCardIndex = cardId;
                 previousPlayerId = playerId;
+                cardZones[cardId] = PlayFieldZone;
                 playedCard = list[cardId];
+                playedSignal = moveSignal;
+                moveSignal = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+            }
+            playedSignal.TrySetResult();
+
+            // Push the move to every connected client as a binary Move message, they ignore their own moves
+            var moveFrame = WireProtocol.EncodeMove(playerId, cardId);
+            foreach (var kvp in playerService.GetAllPlayers())
+            {
+                if (kvp.Value.Socket != null && kvp.Value.Socket.State == WebSocketState.Open)
+                {
+                    await SocketHandler.SendBinaryAsync(kvp.Value.Socket, moveFrame);
+                }
             }
 
             Console.WriteLine($"Player {playerId} played card with index: {cardId}");
-            return $"Player {playerId} played card: {playedCard}";
-        });
+            return (StatusCodes.Status200OK, $"Player {playerId} played card: {playedCard}");
+        }
 
-        routeBuilder.MapGet("/play/{playerId:int}", async (int playerId) =>
+        // With a wait the request is held until the opponent plays (long poll fallback for clients without a socket)
+        async Task<(int status, object body)> CheckPlay(int playerId, int wait)
         {
-            int lastPlayedIndex;
-            int lastPlayer;
-
-            lock (_gameLock)
+            var deadline = DateTime.UtcNow.AddSeconds(Math.Clamp(wait, 0, 60));
+            while (true)
             {
-                lastPlayedIndex = previousPlayedCardIndex;
-                lastPlayer = previousPlayerId;
+                int lastPlayedIndex;
+                int lastPlayer;
+                Task signal;
+
+                lock (_gameLock)
+                {
+                    lastPlayedIndex = previousPlayedCardIndex;
+                    lastPlayer = previousPlayerId;
+                    signal = moveSignal.Task;
+                }
+
+                if (playerId != lastPlayer && lastPlayedIndex != -1)
+                {
+                    Console.WriteLine($"Player {playerId} is checking the last played card index: {lastPlayedIndex}");
+                    return (StatusCodes.Status200OK, lastPlayedIndex);
+                }
+
+                var remaining = deadline - DateTime.UtcNow;
+                if (remaining <= TimeSpan.Zero)
+                {
+                    return (StatusCodes.Status400BadRequest, lastPlayedIndex == -1 ? "No card has been played yet" : "Not your turn");
+                }
+                await Task.WhenAny(signal, Task.Delay(remaining));
             }
+        }
+
+        // ?count= also deals the deck of that many cards, as /shuffle does, so plays can be checked
+        (int status, object body) Seed(int count)
+        {
+            if (count < 0 || count > MaxCards) return (StatusCodes.Status400BadRequest, "Invalid card count");
+            if (count > 0) Shuffle(count);
+            return (StatusCodes.Status200OK, seed.ToString());
+        }
 
-            if (playerId == lastPlayer)
+        routeBuilder.MapGet("/seed", (int? count) =>
+        {
+            var (status, body) = Seed(count ?? 0);
+            return status == StatusCodes.Status200OK ? Results.Text((string)body) : Results.Json(body, statusCode: status);
+        });
+
+        routeBuilder.MapGet("/shuffle/{count:int}", (int count) =>
+        {
+            var (status, body) = Shuffle(count);
+            return Results.Json(body, statusCode: status);
+        });
+
+        routeBuilder.MapPost("/play/{playerId:int}/{cardId:int}", async (int playerId, int cardId, PlayerService playerService) =>
+        {
+            var (status, body) = await Play(playerId, cardId, playerService);
+            return Results.Text((string)body, statusCode: status);
+        });
+
+        routeBuilder.MapGet("/play/{playerId:int}", async (int playerId, int? wait) =>
+        {
+            var (status, body) = await CheckPlay(playerId, wait ?? 0);
+            return Results.Json(body, statusCode: status);
+        });
+
+        // Several game requests in one round trip, run in order: [{ "method": "POST", "path": "/play/0/3", "body": "" }, ...]
+        // Answers with one { "status", "body" } per request, bodies as the single request would have sent them
+        routeBuilder.MapPost("/batch", async (List<BatchRequest> requests, PlayerService playerService) =>
+        {
+            var responses = new List<BatchResponse>();
+            foreach (var request in requests)
             {
-                return Results.BadRequest("Not your turn");
-            }
+                var pathAndQuery = request.Path.Split('?', 2);
+                var segments = pathAndQuery[0].Split('/', StringSplitOptions.RemoveEmptyEntries);
+                var query = QueryHelpers.ParseQuery(pathAndQuery.Length > 1 ? pathAndQuery[1] : string.Empty);
+                (int status, object body) result = (StatusCodes.Status404NotFound, "Not batchable");
+                if (request.Method == "GET" && segments.Length == 1 && segments[0] == "seed")
+                {
+                    if (!query.TryGetValue("count", out var countValue))
+                        result = Seed(0);
+                    else if (int.TryParse(countValue, out var seedCount))
+                        result = Seed(seedCount);
+                    else
+                        result = (StatusCodes.Status400BadRequest, "Invalid card count");
+                }
+                else if (request.Method == "GET" && segments.Length == 2 && segments[0] == "shuffle" && int.TryParse(segments[1], out var count))
+                {
+                    result = Shuffle(count);
+                }
+                else if (request.Method == "POST" && segments.Length == 3 && segments[0] == "play" &&
+                         int.TryParse(segments[1], out var playerId) && int.TryParse(segments[2], out var cardId))
+                {
+                    result = await Play(playerId, cardId, playerService);
+                }
+                else if (request.Method == "GET" && segments.Length == 2 && segments[0] == "play" && int.TryParse(segments[1], out var checkingPlayerId))
+                {
+                    result = await CheckPlay(checkingPlayerId, 0);
+                }
 
-            if (lastPlayedIndex == -1) return Results.BadRequest("No card has been played yet");
-            Console.WriteLine($"Player {playerId} is checking the last played card index: {lastPlayedIndex}");
-            return Results.Ok(lastPlayedIndex);
+                responses.Add(new BatchResponse
+                {
+                    Status = result.status,
+                    Body = result.body as string ?? JsonSerializer.Serialize(result.body)
+                });
+            }
+            return Results.Ok(responses);
         });
 
     }
@@ -269,6 +269,11 @@ public class SocketHandler(PlayerService playerService)
         await socket.SendAsync(buffer, WebSocketMessageType.Text, true, CancellationToken.None);
     }
 
+    public static async Task SendBinaryAsync(WebSocket socket, byte[] frame)
+    {
+        await socket.SendAsync(frame, WebSocketMessageType.Binary, true, CancellationToken.None);
+    }
+
     public static async Task SendMessageAsync(WebSocket socket, object data)
     {
         var json = JsonSerializer.Serialize(data);
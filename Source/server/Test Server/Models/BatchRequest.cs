@@ -0,0 +1,21 @@
+using System.Text.Json.Serialization;
+
+namespace Test_Server.Models;
+
+public class BatchRequest
+{
+    [JsonPropertyName("method")]
+    public string Method { get; set; } = "GET";
+    [JsonPropertyName("path")]
+    public required string Path { get; set; }
+    [JsonPropertyName("body")]
+    public string Body { get; set; } = string.Empty;
+}
+
+public class BatchResponse
+{
+    [JsonPropertyName("status")]
+    public int Status { get; set; }
+    [JsonPropertyName("body")]
+    public string Body { get; set; } = string.Empty;
+}
@@ -0,0 +1,78 @@
+using System.Security.Cryptography;
+
+namespace Test_Server.Models;
+
+// xoshiro256** seeded through splitmix64, same draws as Source/core/logic/GameRandom.h
+// so the client rebuilds the deck order from the seed alone
+public class GameRandom
+{
+    private readonly ulong[] _state = new ulong[4];
+
+    public GameRandom(ulong seed)
+    {
+        var state = seed;
+        for (var i = 0; i < 4; i++)
+        {
+            _state[i] = SplitMix64(ref state);
+        }
+    }
+
+    public static ulong MakeSeed()
+    {
+        return BitConverter.ToUInt64(RandomNumberGenerator.GetBytes(8));
+    }
+
+    public ulong Next()
+    {
+        var result = RotateLeft(_state[1] * 5, 7) * 9;
+        var t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = RotateLeft(_state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, bound), Lemire's multiply and reject
+    public uint NextBelow(uint bound)
+    {
+        var product = (ulong)(uint)(Next() >> 32) * bound;
+        var low = (uint)product;
+        if (low < bound)
+        {
+            var threshold = (uint)(-(long)bound) % bound;
+            while (low < threshold)
+            {
+                product = (ulong)(uint)(Next() >> 32) * bound;
+                low = (uint)product;
+            }
+        }
+        return (uint)(product >> 32);
+    }
+
+    public List<int> ShuffleOrder(int count)
+    {
+        var order = Enumerable.Range(0, Math.Max(count, 0)).ToList();
+        for (var i = order.Count - 1; i > 0; i--)
+        {
+            var j = (int)NextBelow((uint)(i + 1));
+            (order[i], order[j]) = (order[j], order[i]);
+        }
+        return order;
+    }
+
+    private static ulong RotateLeft(ulong value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    private static ulong SplitMix64(ref ulong state)
+    {
+        var z = state += 0x9E3779B97F4A7C15UL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+        return z ^ (z >> 31);
+    }
+}
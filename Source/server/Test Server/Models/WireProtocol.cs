@@ -0,0 +1,62 @@
+namespace Test_Server.Models;
+
+// Binary game messages, same layout as Source/core/network/protocol/WireProtocol.h:
+// u8 version, u8 type, u16 payload size (little endian), then zigzag varint fields
+public static class WireProtocol
+{
+    public const byte Version = 1;
+
+    public enum MessageType : byte
+    {
+        Move = 1,
+        Shuffle = 2,
+        Deal = 3,
+        StateDelta = 4,
+        Seed = 5,
+    }
+
+    public static byte[] EncodeMove(int playerId, int cardId)
+    {
+        var payload = new List<byte>();
+        WriteSigned(payload, playerId);
+        WriteSigned(payload, cardId);
+        return Frame(MessageType.Move, payload);
+    }
+
+    public static byte[] EncodeShuffle(IReadOnlyList<int> order)
+    {
+        var payload = new List<byte>();
+        WriteVarint(payload, (ulong)order.Count);
+        foreach (var index in order)
+        {
+            WriteSigned(payload, index);
+        }
+        return Frame(MessageType.Shuffle, payload);
+    }
+
+    private static byte[] Frame(MessageType type, List<byte> payload)
+    {
+        var frame = new byte[4 + payload.Count];
+        frame[0] = Version;
+        frame[1] = (byte)type;
+        frame[2] = (byte)payload.Count;
+        frame[3] = (byte)(payload.Count >> 8);
+        payload.CopyTo(frame, 4);
+        return frame;
+    }
+
+    private static void WriteVarint(List<byte> output, ulong value)
+    {
+        while (value >= 0x80)
+        {
+            output.Add((byte)(value | 0x80));
+            value >>= 7;
+        }
+        output.Add((byte)value);
+    }
+
+    private static void WriteSigned(List<byte> output, long value)
+    {
+        WriteVarint(output, (ulong)((value << 1) ^ (value >> 63)));
+    }
+}
@@ -0,0 +1,120 @@
+#include "GameRoom.h"
+
+#include "core/network/protocol/WireProtocol.h"
+
+#include <algorithm>
+
+std::vector<int> GameRoom::shuffle(int count)
+{
+    if (count <= 0 || count > MAX_CARDS)
+        return {};
+
+    // Both players ask for the deck, only the first ask after a finished or abandoned game deals anew
+    if (_order.size() != size_t(count) || _previousPlayerId != -1)
+        startGame(count);
+    return _order;
+}
+
+void GameRoom::startGame(int count)
+{
+    // Every game draws its own seed, a replayed seed would replay the deal
+    if (!_order.empty())
+        _seed = GameRandom::makeSeed();
+    _order = GameRandom(_seed).shuffleOrder(count);
+    // Dealt alternately into the two hands, face down
+    _table.reset(count);
+    for (int i = 0; i < count; ++i)
+        _table.setCard(_order[i], {i % 2, i / 2, i % 2, false});
+    _previousPlayedCardIndex = -1;
+    _previousPlayerId        = -1;
+}
+
+bool GameRoom::play(int playerId, int cardId, std::string& message)
+{
+    if (cardId < 0 || size_t(cardId) >= _table.getCardCount())
+    {
+        message = "Invalid index";
+        return false;
+    }
+    if (cardId == _previousPlayedCardIndex && playerId == _previousPlayerId)
+    {
+        // The same move retried after a lost answer, it already went through
+        message = "Player " + std::to_string(playerId) + " played card: " + std::to_string(_order[cardId]);
+        return true;
+    }
+
+    // The table decides: only the owner plays a card, and only while it is still in their hand
+    // (each hand is the zone numbered after its player, see shuffle)
+    auto card = _table.getCard(cardId);
+    if (playerId == _previousPlayerId)
+        message = "Not your turn";
+    else if (card.zoneIndex == TableState::PLAY_FIELD_ZONE)
+        message = "Card already played";
+    else if (card.owner != playerId || card.zoneIndex != playerId)
+        message = "Not your card";
+    if (!message.empty())
+        return false;
+
+    _previousPlayedCardIndex = cardId;
+    _previousPlayerId        = playerId;
+    message = "Player " + std::to_string(playerId) + " played card: " + std::to_string(_order[cardId]);
+    _table.setCard(cardId, {TableState::PLAY_FIELD_ZONE, _table.countInZone(TableState::PLAY_FIELD_ZONE), card.owner, true});
+
+    // Answer the opponent's long polls, keep the mover's own checks parked
+    auto opponentChecks = std::stable_partition(_checks.begin(), _checks.end(),
+                                                [playerId](const PendingCheck& check) { return check.playerId == playerId; });
+    std::vector<PendingCheck> answered(std::make_move_iterator(opponentChecks), std::make_move_iterator(_checks.end()));
+    _checks.erase(opponentChecks, _checks.end());
+    for (auto& check : answered)
+        check.callback(true, cardId, "");
+
+    // Push the move as a binary Move message, clients ignore their own moves
+    std::vector<uint8_t> frame;
+    wire::encodeMove(frame, {playerId, cardId});
+    broadcastBinary(frame);
+    return true;
+}
+
+void GameRoom::checkPlay(int playerId, Clock::time_point deadline, CheckCallback callback)
+{
+    if (playerId != _previousPlayerId && _previousPlayedCardIndex != -1)
+        callback(true, _previousPlayedCardIndex, "");
+    else if (deadline <= Clock::now())
+        callback(false, -1, _previousPlayedCardIndex == -1 ? "No card has been played yet" : "Not your turn");
+    else
+        _checks.push_back({playerId, deadline, std::move(callback)});
+}
+
+void GameRoom::expireChecks(Clock::time_point now)
+{
+    auto expired = std::stable_partition(_checks.begin(), _checks.end(),
+                                         [now](const PendingCheck& check) { return check.deadline > now; });
+    std::vector<PendingCheck> answered(std::make_move_iterator(expired), std::make_move_iterator(_checks.end()));
+    _checks.erase(expired, _checks.end());
+    for (auto& check : answered)
+        check.callback(false, -1, _previousPlayedCardIndex == -1 ? "No card has been played yet" : "Not your turn");
+}
+
+void GameRoom::addMember(const Member& member)
+{
+    removeMember(member.authToken);
+    _members.push_back(member);
+}
+
+void GameRoom::removeMember(const std::string& authToken)
+{
+    std::erase_if(_members, [&](const Member& member) { return member.authToken == authToken; });
+}
+
+void GameRoom::broadcast(const lib::json& message, const SocketSession* except) const
+{
+    for (auto& member : _members)
+        if (member.session.get() != except)
+            member.session->send(message);
+}
+
+void GameRoom::broadcastBinary(const std::vector<uint8_t>& frame) const
+{
+    for (auto& member : _members)
+        member.session->sendBinary(frame);
+}
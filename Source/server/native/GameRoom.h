@@ -0,0 +1,79 @@
+#pragma once
+
+#include "core/logic/GameRandom.h"
+#include "core/logic/TableState.h"
+#include "SocketSession.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One room: its connected players, deck order and turn state, the same rules as the Test Server's
+// demo endpoints. A room belongs to one RoomWorker and is only touched on that worker's thread, so
+// it needs no lock.
+class GameRoom
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int MAX_CARDS = 1024;  // Largest deck a room deals, bigger counts are refused
+    // played, the card index when played, otherwise the reason
+    using CheckCallback = std::function<void(bool played, int cardIndex, const std::string& message)>;
+
+    struct Member
+    {
+        std::string authToken;
+        std::string username;
+        std::shared_ptr<SocketSession> session;  // Stays a member while reconnecting
+    };
+
+    // Clients derive the deck order from the seed with GameRandom, exactly as shuffle does. The
+    // seed is the current game's, each new game draws another.
+    uint64_t getSeed() const { return _seed; }
+    // Card index at each deck position, the first shuffleOrder drawn from the game's seed. Starts a
+    // new game when no deck of count cards is dealt yet or a card of the current game was played:
+    // the table is dealt the way DealCommand does and the turn starts over. Until then both players
+    // get the same order. count must be at most MAX_CARDS.
+    std::vector<int> shuffle(int count);
+    // The table changes after sinceVersion as a wire STATE_DELTA frame, a snapshot when too old
+    void encodeTable(std::vector<uint8_t>& out, uint32_t sinceVersion) const { _table.encodeSince(out, sinceVersion); }
+
+    // Records the move, answers the opponent's waiting checks and pushes the move to every member.
+    // Returns false with the reason in message when the move is refused: out of turn, or a card
+    // that is not in the player's hand on the table. Repeating the last move
+    // succeeds again without effect, so a retried request is safe.
+    bool play(int playerId, int cardId, std::string& message);
+
+    // Answers with the card the opponent of playerId last played. Until the opponent plays the
+    // callback is parked, and expireChecks answers it once deadline has passed.
+    void checkPlay(int playerId, Clock::time_point deadline, CheckCallback callback);
+    void expireChecks(Clock::time_point now);
+
+    void addMember(const Member& member);
+    void removeMember(const std::string& authToken);
+    const std::vector<Member>& getMembers() const { return _members; }
+    bool isIdle() const { return _members.empty() && _checks.empty(); }
+
+    // Sends to members only, except may be null
+    void broadcast(const lib::json& message, const SocketSession* except) const;
+    void broadcastBinary(const std::vector<uint8_t>& frame) const;
+
+private:
+    void startGame(int count);
+
+    struct PendingCheck
+    {
+        int playerId;
+        Clock::time_point deadline;
+        CheckCallback callback;
+    };
+
+    uint64_t _seed = GameRandom::makeSeed();
+    std::vector<int> _order;
+    TableState _table;
+    int _previousPlayedCardIndex = -1;
+    int _previousPlayerId        = -1;
+    std::vector<Member> _members;
+    std::vector<PendingCheck> _checks;
+};
@@ -0,0 +1,485 @@
+#include "GameServer.h"
+
+#include "core/network/protocol/BodyParser.h"
+#include "core/network/protocol/WireProtocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <thread>
+
+using json = lib::json;
+
+namespace
+{
+constexpr const char* JSON_TYPE = "application/json; charset=utf-8";
+constexpr const char* TEXT_TYPE = "text/plain; charset=utf-8";
+
+long long unixTime()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// Splits "/play/0/3" into its non-empty segments
+std::vector<std::string_view> splitPath(std::string_view path)
+{
+    std::vector<std::string_view> segments;
+    while (!path.empty())
+    {
+        auto slash = path.find('/');
+        if (slash != 0)
+            segments.push_back(path.substr(0, slash));
+        if (slash == std::string_view::npos)
+            break;
+        path.remove_prefix(slash + 1);
+    }
+    return segments;
+}
+}  // namespace
+
+GameServer::GameServer(size_t threadCount, size_t workerCount) : _rooms(workerCount)
+{
+    // Connections past the pool's limit wait in a queue as long as the pool, any more are closed
+    // straight away rather than left hanging
+    _server.new_task_queue = [threadCount] {
+        return new lib::ThreadPool(threadCount, threadCount * POOL_GROWTH, threadCount);
+    };
+    mapDemoEndpoints();
+    mapMainEndpoints();
+    mapWebSocket();
+}
+
+bool GameServer::listen(const std::string& host, int port)
+{
+    return _server.listen(host, port);
+}
+
+void GameServer::stop()
+{
+    _server.stop();
+}
+
+void GameServer::mapDemoEndpoints()
+{
+    _server.Get("/", [this](const lib::Request&, lib::Response& res) {
+        auto index = _playerCount++;
+        std::printf("There are %d players. Current index: %d\n", index + 1, index);
+        res.set_content(std::to_string(index), JSON_TYPE);
+    });
+
+    // The room's game seed, clients shuffle with GameRandom instead of downloading the order.
+    // ?count= also deals the room's deck of that many cards, as /shuffle does, so plays can be checked.
+    _server.Get("/seed", [this](const lib::Request& req, lib::Response& res) {
+        int count = 0;
+        if (req.has_param("count") && !body::parseInt(req.get_param_value("count"), count))
+        {
+            res.status = 400;
+            return;
+        }
+        auto result = seed(getRoomId(req), count);
+        res.status  = result.status;
+        res.set_content(result.isMessage ? json(result.body).dump() : result.body, JSON_TYPE);
+    });
+
+    // Table changes since the client's last applied version as one binary STATE_DELTA frame
+    _server.Get("/state", [this](const lib::Request& req, lib::Response& res) {
+        int since = 0;
+        if (req.has_param("since") && (!body::parseInt(req.get_param_value("since"), since) || since < 0))
+        {
+            res.status = 400;
+            return;
+        }
+        auto frame = _rooms.call(getRoomId(req), [since](GameRoom& room) {
+            std::vector<uint8_t> out;
+            room.encodeTable(out, uint32_t(since));
+            return out;
+        });
+        res.set_content(std::string(frame.begin(), frame.end()), "application/octet-stream");
+    });
+
+    _server.Get("/shuffle/:count", [this](const lib::Request& req, lib::Response& res) {
+        int count;
+        if (!body::parseInt(req.path_params.at("count"), count))
+        {
+            res.status = 404;
+            return;
+        }
+        auto result = shuffle(getRoomId(req), count);
+        res.status  = result.status;
+        res.set_content(result.isMessage ? json(result.body).dump() : result.body, JSON_TYPE);
+    });
+
+    _server.Post("/play/:playerId/:cardId", [this](const lib::Request& req, lib::Response& res) {
+        int playerId, cardId;
+        if (!body::parseInt(req.path_params.at("playerId"), playerId) ||
+            !body::parseInt(req.path_params.at("cardId"), cardId))
+        {
+            res.status = 404;
+            return;
+        }
+        auto result = play(getRoomId(req), playerId, cardId);
+        res.status  = result.status;
+        res.set_content(result.body, TEXT_TYPE);
+    });
+
+    // With a wait the request is held until the opponent plays (long poll fallback for clients without a socket)
+    _server.Get("/play/:playerId", [this](const lib::Request& req, lib::Response& res) {
+        int playerId, wait = 0;
+        if (!body::parseInt(req.path_params.at("playerId"), playerId) ||
+            (req.has_param("wait") && !body::parseInt(req.get_param_value("wait"), wait)))
+        {
+            res.status = req.has_param("wait") ? 400 : 404;
+            return;
+        }
+        auto result = checkPlay(getRoomId(req), playerId, wait);
+        res.status  = result.status;
+        res.set_content(result.isMessage ? json(result.body).dump() : result.body, JSON_TYPE);
+    });
+
+    // Several game requests in one round trip, run in order: [{ "method": "POST", "path": "/play/0/3", "body": "" }, ...]
+    // Answers with one { "status", "body" } per request, bodies as the single request would have sent them
+    _server.Post("/batch", [this](const lib::Request& req, lib::Response& res) {
+        auto requests = json::parse(req.body, nullptr, false);
+        if (!requests.is_array())
+        {
+            res.status = 400;
+            return;
+        }
+        auto roomId    = getRoomId(req);
+        json responses = json::array();
+        for (auto& request : requests)
+        {
+            if (!request.is_object() || !request.value("method", json("GET")).is_string() ||
+                !request.value("path", json("")).is_string())
+            {
+                responses.push_back({{"status", 400}, {"body", "Invalid batch entry"}});
+                continue;
+            }
+            auto result = runBatched(roomId, request.value("method", "GET"), request.value("path", ""));
+            responses.push_back({{"status", result.status}, {"body", result.body}});
+        }
+        res.set_content(responses.dump(), JSON_TYPE);
+    });
+}
+
+void GameServer::mapMainEndpoints()
+{
+    _server.Post("/login", [this](const lib::Request& req, lib::Response& res) {
+        auto request = json::parse(req.body, nullptr, false);
+        if (!request.is_object() || !request.contains("username") || !request.contains("password"))
+        {
+            res.status = 400;
+            res.set_content(json({{"error", "Invalid request body"}}).dump(), JSON_TYPE);
+            return;
+        }
+        Player player;
+        player.username  = request.value("username", "");
+        player.authToken = newToken();
+        if (!_players.add(player))
+        {
+            res.status = 400;
+            res.set_content(json({{"error", "Failed to create player"}}).dump(), JSON_TYPE);
+            return;
+        }
+        res.set_content(json({{"auth_token", player.authToken}}).dump(), JSON_TYPE);
+    });
+
+    _server.Post("/logout", [this](const lib::Request& req, lib::Response& res) {
+        auto authToken = req.get_header_value("Authorization");
+        if (authToken.empty())
+        {
+            res.status = 400;
+            res.set_content(json({{"error", "Missing Authorization header"}}).dump(), JSON_TYPE);
+            return;
+        }
+        _players.remove(authToken);
+        res.set_content(json({{"message", "Logged out successfully"}}).dump(), JSON_TYPE);
+    });
+
+    _server.Post("/signup", [](const lib::Request& req, lib::Response& res) {
+        auto request = json::parse(req.body, nullptr, false);
+        if (!request.is_object() || !request.contains("username") || !request.contains("password"))
+        {
+            res.status = 400;
+            res.set_content(json({{"error", "Invalid request body"}}).dump(), JSON_TYPE);
+            return;
+        }
+        res.set_content(json({{"message", "Signup successful"}}).dump(), JSON_TYPE);
+    });
+}
+
+void GameServer::mapWebSocket()
+{
+    // Refuse unknown tokens before the upgrade, as the C# endpoint answers 401
+    _server.set_pre_routing_handler([this](const lib::Request& req, lib::Response& res) {
+        if (req.path == "/ws" && !_players.contains(req.get_header_value("Authorization")))
+        {
+            res.status = 401;
+            return lib::Server::HandlerResponse::Handled;
+        }
+        return lib::Server::HandlerResponse::Unhandled;
+    });
+
+    _server.WebSocket("/ws", [this](const lib::Request& req, lib::ws::WebSocket& socket) {
+        Player user;
+        if (!_players.get(req.get_header_value("Authorization"), user))
+            return;
+        // A reconnecting client passes the last seq it received and gets everything after it
+        std::optional<uint64_t> sinceSeq;
+        uint64_t since;
+        if (req.has_param("since") && body::parseUInt64(req.get_param_value("since"), since))
+            sinceSeq = since;
+
+        // Still a member when resuming within the grace period, addMember just replaces the entry
+        auto roomId = user.roomId;
+        user.session->attach(&socket, sinceSeq);
+        std::thread writer([&socket, session = user.session] { session->drain(&socket); });
+        _rooms.call(roomId, [&](GameRoom& room) { room.addMember({user.authToken, user.username, user.session}); });
+        std::printf("[WebSocket] %s: %s\n", sinceSeq ? "Resumed" : "Connected", user.username.c_str());
+
+        std::string message;
+        while (auto kind = socket.read(message))
+        {
+            if (kind == lib::ws::Text)
+                handleSocketMessage(user, roomId, message);
+        }
+
+        // Nothing is sent on the socket once detached, messages wait in the session for a resume
+        user.session->detach(&socket);
+        writer.join();
+        _rooms.postAt(roomId, GameRoom::Clock::now() + RESUME_GRACE,
+                      [session = user.session, authToken = user.authToken](GameRoom& room) {
+            if (!session->isAttached())
+                room.removeMember(authToken);
+        });
+        std::printf("[WebSocket] Disconnected: %s\n", user.username.c_str());
+    });
+}
+
+std::string GameServer::getRoomId(const lib::Request& req) const
+{
+    if (req.has_param("room"))
+        return req.get_param_value("room");
+    // Logged in players play in the room their socket joined
+    Player player;
+    if (_players.get(req.get_header_value("Authorization"), player))
+        return player.roomId;
+    return std::string();
+}
+
+GameServer::Result GameServer::seed(const std::string& roomId, int count)
+{
+    if (count < 0 || count > GameRoom::MAX_CARDS)
+        return {400, "Invalid card count", true};
+    return {200, std::to_string(_rooms.call(roomId, [count](GameRoom& room) {
+        room.shuffle(count);
+        return room.getSeed();
+    }))};
+}
+
+GameServer::Result GameServer::shuffle(const std::string& roomId, int count)
+{
+    // The whole order is allocated and dealt, an unbounded count would take the server down
+    if (count > GameRoom::MAX_CARDS)
+        return {400, "Too many cards", true};
+    return {200, json(_rooms.call(roomId, [count](GameRoom& room) { return room.shuffle(count); })).dump()};
+}
+
+GameServer::Result GameServer::play(const std::string& roomId, int playerId, int cardId)
+{
+    return _rooms.call(roomId, [&](GameRoom& room) {
+        // 409 tells the client to roll back the move it already showed
+        std::string message;
+        bool played = room.play(playerId, cardId, message);
+        return Result{played ? 200 : 409, message, true};
+    });
+}
+
+GameServer::Result GameServer::checkPlay(const std::string& roomId, int playerId, int waitSeconds)
+{
+    // The room answers straight away or parks the check, this request thread waits either way
+    auto deadline = GameRoom::Clock::now() + std::chrono::seconds(std::clamp(waitSeconds, 0, 60));
+    std::promise<Result> answer;
+    _rooms.post(roomId, [&](GameRoom& room) {
+        room.checkPlay(playerId, deadline, [&](bool played, int cardIndex, const std::string& message) {
+            answer.set_value(played ? Result{200, std::to_string(cardIndex)} : Result{400, message, true});
+        });
+    });
+    if (waitSeconds > 0)
+        _rooms.postAt(roomId, deadline, [deadline](GameRoom& room) { room.expireChecks(deadline); });
+    return answer.get_future().get();
+}
+
+GameServer::Result GameServer::runBatched(const std::string& roomId, const std::string& method,
+                                          const std::string& path)
+{
+    std::string_view route = path, query;
+    if (auto queryStart = route.find('?'); queryStart != std::string_view::npos)
+    {
+        query = route.substr(queryStart + 1);
+        route = route.substr(0, queryStart);
+    }
+    auto segments = splitPath(route);
+    int first, second;
+    if (method == "GET" && segments.size() == 1 && segments[0] == "seed")
+    {
+        // The only query a batched route takes is /seed's count
+        if (query.empty())
+            return seed(roomId, 0);
+        if (query.starts_with("count=") && body::parseInt(query.substr(6), first))
+            return seed(roomId, first);
+        return {400, "Invalid card count", true};
+    }
+    if (method == "GET" && segments.size() == 2 && segments[0] == "shuffle" && body::parseInt(segments[1], first))
+        return shuffle(roomId, first);
+    if (method == "POST" && segments.size() == 3 && segments[0] == "play" && body::parseInt(segments[1], first) &&
+        body::parseInt(segments[2], second))
+        return play(roomId, first, second);
+    if (method == "GET" && segments.size() == 2 && segments[0] == "play" && body::parseInt(segments[1], first))
+        return checkPlay(roomId, first, 0);
+    return {404, "Not batchable", true};
+}
+
+void GameServer::handleSocketMessage(const Player& user, std::string& roomId, const std::string& text)
+{
+    auto& session = *user.session;
+    auto message  = json::parse(text, nullptr, false);
+    if (!message.is_object())
+    {
+        sendError(session, "Invalid JSON format");
+        return;
+    }
+    auto id = message.value("id", json(0));
+    if (!session.receive(id.is_number_unsigned() ? id.get<uint64_t>() : 0))
+        return;  // Resent after a reconnect, it already ran
+
+    auto command = message.value("command", "");
+    auto data    = message.contains("data") ? message["data"] : json();
+    if (command == "broadcast")
+    {
+        if (data.is_null())
+            sendError(session, "Missing data property");
+        else if (roomId.empty())
+            sendError(session, "User must be in a room to broadcast messages");
+        else
+        {
+            auto relayed = json({{"type", "broadcast"},
+                                 {"command", "broadcast"},
+                                 {"data", data},
+                                 {"time_stamp", unixTime()},
+                                 {"from", user.username}});
+            _rooms.post(roomId, [relayed, except = &session](GameRoom& room) { room.broadcast(relayed, except); });
+        }
+    }
+    else if (command == "create_room")
+    {
+        moveToRoom(user, roomId, newToken(), json());
+        session.send(json({{"type", "response"},
+                           {"command", "create_room"},
+                           {"data", {{"room_id", roomId}}},
+                           {"time_stamp", unixTime()}}));
+    }
+    else if (command == "join_room")
+    {
+        if (!data.is_object() || !data.contains("room_id") || !data["room_id"].is_string())
+        {
+            sendError(session, data.is_null() ? "Missing data property" : "Missing room_id property");
+            return;
+        }
+        session.send(json({{"type", "response"},
+                           {"command", "join_room"},
+                           {"data", {{"room_id", data["room_id"]}}},
+                           {"time_stamp", unixTime()}}));
+        moveToRoom(user, roomId, data["room_id"].get<std::string>(),
+                   {{"type", "broadcast"},
+                    {"command", "user_joined"},
+                    {"data", {{"username", user.username}}},
+                    {"time_stamp", unixTime()}});
+    }
+    else if (command == "leave_room")
+    {
+        auto announcement = json({{"type", "broadcast"},
+                                  {"command", "user_left"},
+                                  {"data", {{"username", user.username}}},
+                                  {"time_stamp", unixTime()}});
+        _rooms.post(roomId,
+                    [announcement, except = &session](GameRoom& room) { room.broadcast(announcement, except); });
+        moveToRoom(user, roomId, "", json());
+        session.send(json({{"type", "response"},
+                           {"command", "leave_room"},
+                           {"data", json::object()},
+                           {"time_stamp", unixTime()}}));
+    }
+    else if (command == "list_rooms")
+    {
+        json list = json::array();
+        _rooms.forEachRoom([&](const std::string& id, const GameRoom& room) {
+            if (id.empty() || room.getMembers().empty())
+                return;
+            json users = json::array();
+            for (auto& member : room.getMembers())
+                users.push_back(member.username);
+            list.push_back({{"room_id", id}, {"users", users}});
+        });
+        session.send(
+            json({{"type", "response"}, {"command", "list_rooms"}, {"data", list}, {"time_stamp", unixTime()}}));
+    }
+    else if (command == "list_users_in_room")
+    {
+        if (roomId.empty())
+        {
+            sendError(session, "User must be in a room to list users");
+            return;
+        }
+        auto users = _rooms.call(roomId, [](GameRoom& room) {
+            json users = json::array();
+            for (auto& member : room.getMembers())
+                users.push_back(member.username);
+            return users;
+        });
+        session.send(json({{"type", "response"},
+                           {"command", "list_users_in_room"},
+                           {"data", {{"user_list", users}}},
+                           {"time_stamp", unixTime()}}));
+    }
+    else
+    {
+        std::printf("[WebSocket] '%s' not found\n", command.c_str());
+        sendError(session, "Unknown command");
+    }
+}
+
+void GameServer::moveToRoom(const Player& user, std::string& roomId, const std::string& newRoomId,
+                            const json& announcement)
+{
+    _rooms.call(roomId, [&](GameRoom& room) { room.removeMember(user.authToken); });
+    _rooms.removeIfIdle(roomId);
+    roomId = newRoomId;
+    _players.setRoom(user.authToken, roomId);
+
+    // Announce before joining so the newcomer does not hear about itself
+    _rooms.call(roomId, [&](GameRoom& room) {
+        if (!announcement.is_null())
+            room.broadcast(announcement, user.session.get());
+        room.addMember({user.authToken, user.username, user.session});
+    });
+}
+
+void GameServer::sendError(SocketSession& session, const std::string& message)
+{
+    session.send(json({{"result", "ERROR"}, {"message", message}}));
+}
+
+std::string GameServer::newToken()
+{
+    // 128 random bits as 32 hex digits, the same shape as the C# Guid "N" format
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    char token[33];
+    std::snprintf(token, sizeof(token), "%016llx%016llx", (unsigned long long)engine(), (unsigned long long)engine());
+    return token;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "PlayerRegistry.h"
+#include "RoomRegistry.h"
+
+// json.hpp first, httplib.h also declares lib::detail and breaks json.hpp's lookups
+#include "utils/json.hpp"
+#include "utils/httplib.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Native drop-in for the C# Test Server: the same HTTP routes and /ws protocol on one port.
+//
+// Game state lives in rooms picked by the "room" query parameter or, for a logged in player, by the
+// create_room and join_room their socket last sent (neither is the shared demo room). Each room belongs to one RoomWorker; request
+// threads hand it work and wait, and broadcasts only visit the room's own members.
+class GameServer
+{
+public:
+    // httplib serves each connection on a pool thread for as long as it is open, so every WebSocket
+    // and long poll holds one (a WebSocket also runs its own ping and writer threads). The pool starts with
+    // threadCount threads and grows to POOL_GROWTH times that, the most connections served at once.
+    static constexpr size_t POOL_GROWTH = 4;
+
+    // workerCount threads own the rooms
+    GameServer(size_t threadCount, size_t workerCount);
+
+    bool listen(const std::string& host, int port);
+    void stop();
+
+private:
+    struct Result
+    {
+        int status;
+        std::string body;
+        bool isMessage = false;  // body is a plain message rather than JSON
+    };
+
+    // How long a dropped player stays in their room, waiting to resume with ?since=
+    static constexpr std::chrono::seconds RESUME_GRACE{30};
+
+    void mapDemoEndpoints();
+    void mapMainEndpoints();
+    void mapWebSocket();
+
+    // The ?room= parameter, else the room of the player named by the Authorization header, else the shared demo room
+    std::string getRoomId(const lib::Request& req) const;
+
+    // The demo routes, shared by their own endpoints and /batch
+    Result seed(const std::string& roomId, int count);  // count 0 leaves the deck as it is
+    Result shuffle(const std::string& roomId, int count);
+    Result play(const std::string& roomId, int playerId, int cardId);
+    Result checkPlay(const std::string& roomId, int playerId, int waitSeconds);
+    Result runBatched(const std::string& roomId, const std::string& method, const std::string& path);
+
+    // roomId is the room the player's session is a member of, room commands move it
+    void handleSocketMessage(const Player& user, std::string& roomId, const std::string& text);
+    void moveToRoom(const Player& user, std::string& roomId, const std::string& newRoomId,
+                    const lib::json& announcement);
+    static void sendError(SocketSession& session, const std::string& message);
+    static std::string newToken();
+
+    PlayerRegistry _players;
+    RoomRegistry _rooms;
+    std::atomic<int> _playerCount{0};
+    lib::Server _server;  // Declared last, stops taking requests before the rooms go away
+};
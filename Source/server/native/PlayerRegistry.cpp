@@ -0,0 +1,42 @@
+#include "PlayerRegistry.h"
+
+#include <mutex>
+
+bool PlayerRegistry::add(const Player& player)
+{
+    std::unique_lock lock(_mutex);
+    auto [it, added] = _players.emplace(player.authToken, player);
+    if (added && !it->second.session)
+        it->second.session = std::make_shared<SocketSession>();
+    return added;
+}
+
+void PlayerRegistry::remove(const std::string& authToken)
+{
+    std::unique_lock lock(_mutex);
+    _players.erase(authToken);
+}
+
+bool PlayerRegistry::contains(const std::string& authToken) const
+{
+    std::shared_lock lock(_mutex);
+    return _players.count(authToken) != 0;
+}
+
+bool PlayerRegistry::get(const std::string& authToken, Player& player) const
+{
+    std::shared_lock lock(_mutex);
+    auto it = _players.find(authToken);
+    if (it == _players.end())
+        return false;
+    player = it->second;
+    return true;
+}
+
+void PlayerRegistry::setRoom(const std::string& authToken, const std::string& roomId)
+{
+    std::unique_lock lock(_mutex);
+    auto it = _players.find(authToken);
+    if (it != _players.end())
+        it->second.roomId = roomId;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SocketSession.h"
+
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+struct Player
+{
+    std::string username;
+    std::string authToken;
+    std::string roomId;  // The room the player's socket joins, empty for the shared demo room
+    std::shared_ptr<SocketSession> session;  // Outlives each connection, created by add
+};
+
+// Logged in players by auth token. Lookups share the lock, login, logout and room changes take it alone.
+// Connected sessions are members of their room, see GameRoom.
+class PlayerRegistry
+{
+public:
+    bool add(const Player& player);
+    void remove(const std::string& authToken);
+    bool contains(const std::string& authToken) const;
+
+    // Copies the player out, the registry entry may change as soon as this returns
+    bool get(const std::string& authToken, Player& player) const;
+    void setRoom(const std::string& authToken, const std::string& roomId);
+
+private:
+    mutable std::shared_mutex _mutex;
+    std::unordered_map<std::string, Player> _players;
+};
@@ -0,0 +1,50 @@
+#include "RoomRegistry.h"
+
+#include <algorithm>
+
+RoomRegistry::RoomRegistry(size_t workerCount)
+{
+    for (size_t i = 0; i < std::max<size_t>(workerCount, 1); ++i)
+        _workers.push_back(std::make_unique<RoomWorker>());
+}
+
+void RoomRegistry::post(const std::string& roomId, std::function<void(GameRoom&)> fn)
+{
+    auto& worker = getWorker(roomId);
+    worker.post([&worker, roomId, fn = std::move(fn)] { fn(worker.getRoom(roomId)); });
+}
+
+void RoomRegistry::postAt(const std::string& roomId, GameRoom::Clock::time_point when,
+                          std::function<void(GameRoom&)> fn)
+{
+    auto& worker = getWorker(roomId);
+    worker.postAt(when, [&worker, roomId, fn = std::move(fn)] {
+        if (auto room = worker.findRoom(roomId))
+        {
+            fn(*room);
+            worker.removeRoomIfIdle(roomId);
+        }
+    });
+}
+
+void RoomRegistry::removeIfIdle(const std::string& roomId)
+{
+    auto& worker = getWorker(roomId);
+    worker.post([&worker, roomId] { worker.removeRoomIfIdle(roomId); });
+}
+
+void RoomRegistry::forEachRoom(const std::function<void(const std::string&, const GameRoom&)>& visitor)
+{
+    for (auto& worker : _workers)
+    {
+        worker->call([&] {
+            for (auto& [roomId, room] : worker->getRooms())
+                visitor(roomId, *room);
+        });
+    }
+}
+
+RoomWorker& RoomRegistry::getWorker(const std::string& roomId)
+{
+    return *_workers[std::hash<std::string>()(roomId) % _workers.size()];
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "RoomWorker.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Rooms by id, spread over a fixed set of workers by hashing the id. Finding a room's worker
+// takes no lock and no shared map, each worker keeps the rooms it owns to itself.
+class RoomRegistry
+{
+public:
+    explicit RoomRegistry(size_t workerCount);
+
+    // Runs fn(GameRoom&) on the room's worker and waits for the result, creating the room on first use
+    template <typename Fn>
+    auto call(const std::string& roomId, Fn&& fn)
+    {
+        auto& worker = getWorker(roomId);
+        return worker.call([&] { return fn(worker.getRoom(roomId)); });
+    }
+
+    // Runs fn(GameRoom&) on the room's worker without waiting
+    void post(const std::string& roomId, std::function<void(GameRoom&)> fn);
+    // Runs fn(GameRoom&) on the room's worker once when has passed, skipped if the room is gone by then.
+    // A named room fn leaves idle is dropped.
+    void postAt(const std::string& roomId, GameRoom::Clock::time_point when, std::function<void(GameRoom&)> fn);
+
+    // Drops a named room once it has no members and no parked checks
+    void removeIfIdle(const std::string& roomId);
+
+    // Runs visitor(roomId, room) for every room, one worker at a time, and waits
+    void forEachRoom(const std::function<void(const std::string&, const GameRoom&)>& visitor);
+
+    size_t getWorkerCount() const { return _workers.size(); }
+
+private:
+    RoomWorker& getWorker(const std::string& roomId);
+
+    std::vector<std::unique_ptr<RoomWorker>> _workers;
+};
@@ -0,0 +1,87 @@
+#include "RoomWorker.h"
+
+RoomWorker::RoomWorker() : _thread(&RoomWorker::run, this) {}
+
+RoomWorker::~RoomWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _wake.notify_one();
+    _thread.join();
+}
+
+void RoomWorker::post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _wake.notify_one();
+}
+
+void RoomWorker::postAt(GameRoom::Clock::time_point when, Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _timers.emplace(when, std::move(task));
+    }
+    _wake.notify_one();
+}
+
+GameRoom& RoomWorker::getRoom(const std::string& roomId)
+{
+    auto& room = _rooms[roomId];
+    if (!room)
+        room = std::make_unique<GameRoom>();
+    return *room;
+}
+
+GameRoom* RoomWorker::findRoom(const std::string& roomId)
+{
+    auto it = _rooms.find(roomId);
+    return it == _rooms.end() ? nullptr : it->second.get();
+}
+
+void RoomWorker::removeRoomIfIdle(const std::string& roomId)
+{
+    // The unnamed room is the shared demo game, it stays for the server's lifetime
+    auto it = _rooms.find(roomId);
+    if (!roomId.empty() && it != _rooms.end() && it->second->isIdle())
+        _rooms.erase(it);
+}
+
+void RoomWorker::run()
+{
+    std::vector<Task> tasks;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            // Re-checked on every wake, a timer posted meanwhile may be due before the one waited on
+            auto isDue = [this] { return !_timers.empty() && _timers.begin()->first <= GameRoom::Clock::now(); };
+            while (!_isStopping && _tasks.empty() && !isDue())
+            {
+                if (_timers.empty())
+                    _wake.wait(lock);
+                else
+                    _wake.wait_until(lock, _timers.begin()->first);
+            }
+            if (_isStopping)
+                return;
+
+            // Take the whole queue at once, producers only wait for the swap
+            tasks.swap(_tasks);
+            auto now = GameRoom::Clock::now();
+            while (!_timers.empty() && _timers.begin()->first <= now)
+            {
+                tasks.push_back(std::move(_timers.begin()->second));
+                _timers.erase(_timers.begin());
+            }
+        }
+        for (auto& task : tasks)
+            task();
+        tasks.clear();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "GameRoom.h"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// A thread that owns a set of rooms. Everything that touches one of its rooms runs as a task on
+// this thread, so room state needs no lock and the queue is the only point of contention.
+class RoomWorker
+{
+public:
+    using Task = std::function<void()>;
+
+    RoomWorker();
+    ~RoomWorker();
+
+    void post(Task task);
+    void postAt(GameRoom::Clock::time_point when, Task task);
+
+    // Runs fn on the worker and waits for its result. Never call from the worker itself.
+    template <typename Fn>
+    auto call(Fn&& fn) -> std::invoke_result_t<Fn&>
+    {
+        std::packaged_task<std::invoke_result_t<Fn&>()> task(std::forward<Fn>(fn));
+        auto result = task.get_future();
+        post([&task] { task(); });
+        return result.get();
+    }
+
+    // Worker thread only
+    GameRoom& getRoom(const std::string& roomId);
+    GameRoom* findRoom(const std::string& roomId);
+    void removeRoomIfIdle(const std::string& roomId);
+    const std::unordered_map<std::string, std::unique_ptr<GameRoom>>& getRooms() const { return _rooms; }
+
+private:
+    void run();
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::vector<Task> _tasks;
+    std::multimap<GameRoom::Clock::time_point, Task> _timers;
+    bool _isStopping = false;
+
+    std::unordered_map<std::string, std::unique_ptr<GameRoom>> _rooms;  // Only touched on _thread
+    std::thread _thread;  // Declared last, starts once everything above exists
+};
@@ -0,0 +1,117 @@
+#include "SocketSession.h"
+
+#include "utils/httplib.h"
+
+#include <cstdio>
+
+using json = lib::json;
+
+void SocketSession::send(json message)
+{
+    std::lock_guard lock(_mutex);
+    message["seq"] = ++_lastSent;
+    _sent.emplace_back(_lastSent, message.dump());
+    if (_sent.size() > REPLAY_CAPACITY)
+        _sent.pop_front();
+    queue(_sent.back().second, false);
+}
+
+void SocketSession::sendBinary(const std::vector<uint8_t>& frame)
+{
+    std::lock_guard lock(_mutex);
+    queue(std::string(frame.begin(), frame.end()), true);
+}
+
+void SocketSession::attach(lib::ws::WebSocket* socket, std::optional<uint64_t> sinceSeq)
+{
+    std::lock_guard lock(_mutex);
+    _socket   = socket;
+    _isBehind = false;
+    _outbox.clear();  // Queued for the connection this one replaces, the resume covers what counts
+    _changed.notify_all();
+    if (!sinceSeq)
+        return;
+
+    // Incomplete when messages after sinceSeq have already left the buffer, the client then resyncs instead
+    auto since    = std::min(*sinceSeq, _lastSent);
+    bool complete = since + _sent.size() >= _lastSent;
+    queue(json({{"type", "response"},
+                {"command", "resume"},
+                {"data", {{"received", _lastReceived}, {"complete", complete}}}})
+              .dump(),
+          false);
+    for (auto& [seq, text] : _sent)
+        if (seq > since)
+            queue(text, false);
+}
+
+void SocketSession::detach(const lib::ws::WebSocket* socket)
+{
+    std::lock_guard lock(_mutex);
+    if (_socket != socket)
+        return;
+    _socket = nullptr;
+    _outbox.clear();
+    _changed.notify_all();
+}
+
+void SocketSession::drain(lib::ws::WebSocket* socket)
+{
+    std::unique_lock lock(_mutex);
+    while (true)
+    {
+        _changed.wait(lock, [&] { return _socket != socket || _isBehind || !_outbox.empty(); });
+        if (_socket != socket)
+            return;
+        if (_isBehind)
+            break;
+
+        auto frame = std::move(_outbox.front());
+        _outbox.pop_front();
+        lock.unlock();
+        bool sent = frame.isBinary ? socket->send(frame.data.data(), frame.data.size()) : socket->send(frame.data);
+        lock.lock();
+        if (!sent)
+            break;  // The write timed out or the socket closed
+    }
+
+    // Its reconnect resumes from the last message it got, or resyncs when that left the buffer
+    lock.unlock();
+    if (!socket->is_open())
+        return;
+    std::printf("[WebSocket] Closing a client that stopped reading\n");
+    socket->close(lib::ws::CloseStatus::PolicyViolation, "too far behind");
+}
+
+void SocketSession::queue(std::string data, bool isBinary)
+{
+    if (!_socket || _isBehind)
+        return;
+    if (_outbox.size() >= MAX_QUEUED_FRAMES)
+    {
+        _outbox.clear();
+        _isBehind = true;
+    }
+    else
+    {
+        _outbox.push_back({std::move(data), isBinary});
+    }
+    _changed.notify_all();
+}
+
+bool SocketSession::isAttached() const
+{
+    std::lock_guard lock(_mutex);
+    return _socket != nullptr;
+}
+
+bool SocketSession::receive(uint64_t id)
+{
+    std::lock_guard lock(_mutex);
+    if (id == 0)
+        return true;
+    if (id <= _lastReceived)
+        return false;
+    _lastReceived = id;
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+// json.hpp first, httplib.h also declares lib::detail and breaks json.hpp's lookups
+#include "utils/json.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lib::ws
+{
+class WebSocket;
+}
+
+// One player's socket traffic, kept across reconnects. Outgoing JSON messages are stamped with an
+// increasing "seq" and the latest REPLAY_CAPACITY stay buffered, so a client reconnecting with
+// ?since=N gets exactly the ones it missed. Incoming "id"s already received are reported, so a
+// message the client resends after a drop runs once.
+// Sending only queues the frame, the connection's own writer thread (see drain) does the blocking
+// write, so a slow client never holds up the room worker that broadcast to it.
+class SocketSession
+{
+public:
+    static constexpr size_t REPLAY_CAPACITY   = 256;
+    static constexpr size_t MAX_QUEUED_FRAMES = 1024;  // A client this far behind is disconnected, it resumes
+
+    // Queued when a socket is attached, otherwise it waits in the buffer for the next resume
+    void send(lib::json message);
+    // Game frames are not buffered, clients catch up on the table through GET /state
+    void sendBinary(const std::vector<uint8_t>& frame);
+
+    // Makes socket the session's connection. With sinceSeq it first answers a "resume" response
+    // carrying the last received id, then replays every buffered message after sinceSeq.
+    void attach(lib::ws::WebSocket* socket, std::optional<uint64_t> sinceSeq);
+    // Only detaches socket if a newer connection has not replaced it already
+    void detach(const lib::ws::WebSocket* socket);
+    bool isAttached() const;
+    // Writes the frames queued for socket until it is detached, run on a thread of its own per
+    // connection. Closes socket once MAX_QUEUED_FRAMES have piled up unsent or a write times out.
+    void drain(lib::ws::WebSocket* socket);
+
+    // False when id was already received, id 0 is unsequenced and always accepted
+    bool receive(uint64_t id);
+
+private:
+    struct Frame
+    {
+        std::string data;
+        bool isBinary;
+    };
+
+    void queue(std::string data, bool isBinary);  // Called with _mutex held
+
+    mutable std::mutex _mutex;
+    std::condition_variable _changed;  // Wakes drain: a frame was queued or the socket changed
+    lib::ws::WebSocket* _socket = nullptr;
+    std::deque<Frame> _outbox;  // Oldest first, only for the attached socket
+    bool _isBehind = false;     // The outbox overflowed, drain closes the socket
+    uint64_t _lastSent          = 0;
+    uint64_t _lastReceived      = 0;
+    std::deque<std::pair<uint64_t, std::string>> _sent;  // Oldest first
+};
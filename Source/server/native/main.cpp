@@ -0,0 +1,82 @@
+#include "GameServer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace
+{
+int printUsage()
+{
+    std::fprintf(stderr, "Usage: CardGameServer [--host 0.0.0.0] [--port 5284] [--threads N] [--workers N]\n");
+    return 1;
+}
+
+// The whole argument has to be a number above zero
+bool parseCount(const char* text, size_t& count)
+{
+    char* end;
+    auto value = std::strtoul(text, &end, 10);
+    if (*text < '0' || *text > '9' || *end != '\0' || value == 0)
+        return false;
+    count = value;
+    return true;
+}
+}  // namespace
+
+// CardGameServer [--host 0.0.0.0] [--port 5284] [--threads N] [--workers N]
+int main(int argc, char** argv)
+{
+    std::string host = "0.0.0.0";
+    int port         = 5284;  // Same port as the Test Server, the client needs no change
+    size_t threads   = std::max(64u, std::thread::hardware_concurrency() * 8);  // Pool start, see GameServer::POOL_GROWTH
+    size_t workers   = std::max(1u, std::thread::hardware_concurrency());  // Threads owning the rooms
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        std::string option = argv[i];
+        if (option != "--host" && option != "--port" && option != "--threads" && option != "--workers")
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return printUsage();
+        }
+        if (i + 1 == argc)
+        {
+            std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return printUsage();
+        }
+
+        auto value = argv[i + 1];
+        size_t number = 0;
+        bool valid    = true;
+        if (option == "--host")
+            host = value;
+        else if (option == "--port")
+        {
+            valid = parseCount(value, number) && number <= 65535;
+            port  = int(number);
+        }
+        else if (option == "--threads")
+            valid = parseCount(value, threads);
+        else
+            valid = parseCount(value, workers);
+        if (!valid)
+        {
+            std::fprintf(stderr, "Invalid value for %s: %s\n", argv[i], value);
+            return printUsage();
+        }
+    }
+
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);  // Log lines show up as they happen when piped
+    GameServer server(threads, workers);
+    std::printf("Listening on %s:%d with %zu room workers, serving up to %zu sockets and long polls at once\n",
+                host.c_str(), port, workers, threads * GameServer::POOL_GROWTH);
+    if (!server.listen(host, port))
+    {
+        std::fprintf(stderr, "Could not listen on %s:%d\n", host.c_str(), port);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "core/network/protocol/BodyParser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+// HttpRequestHandler::convertBufferToVectorOfInt before body::parseIntArray replaced it: a string copy
+// of the response, then substr and stoi per element into a new vector
+std::vector<int> convertBufferToVectorOfInt(const std::vector<char>& buffer)
+{
+    std::string str(buffer.data(), buffer.size());
+    std::vector<int> result;
+    size_t start = 1;  // Skip the opening bracket
+    size_t end   = str.find(',', start);
+    while (end != std::string::npos)
+    {
+        result.push_back(std::stoi(str.substr(start, end - start)));
+        start = end + 1;
+        end   = str.find(',', start);
+    }
+    // Add the last element
+    result.push_back(std::stoi(str.substr(start, str.length() - start - 1)));
+    return result;
+}
+
+// The shuffle response for count cards, as the C# Test Server sends it
+std::vector<char> makeShuffleBody(int count)
+{
+    std::string body = "[";
+    for (int i = 0; i < count; ++i)
+        body += (i ? "," : "") + std::to_string((i * 7919) % count);
+    body += "]";
+    return {body.begin(), body.end()};
+}
+
+template <typename Parse>
+double nanosecondsPerParse(int iterations, Parse&& parse)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        parse();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+}  // namespace
+
+// CardGameBodyBench [iterations] : times body::parseIntArray against the substr/stoi path on shuffle bodies
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (iterations <= 0)
+    {
+        std::fprintf(stderr, "Usage: CardGameBodyBench [iterations]\n");
+        return 1;
+    }
+
+    long long checksum = 0;
+    std::vector<int> values;
+    for (int count : {8, 52, 1024})
+    {
+        auto buffer = makeShuffleBody(count);
+        auto text   = std::string_view(buffer.data(), buffer.size());
+        if (!body::parseIntArray(text, values) || values != convertBufferToVectorOfInt(buffer))
+        {
+            std::fprintf(stderr, "The parsers disagree on %d values\n", count);
+            return 1;
+        }
+
+        auto oldTime = nanosecondsPerParse(iterations, [&] { checksum += convertBufferToVectorOfInt(buffer).back(); });
+        auto newTime = nanosecondsPerParse(iterations, [&] {
+            body::parseIntArray(text, values);
+            checksum += values.back();
+        });
+        std::printf("%4d values, %5zu bytes: substr/stoi %9.0f ns, parseIntArray %9.0f ns, %.1fx\n", count,
+                    buffer.size(), oldTime, newTime, oldTime / newTime);
+    }
+    return checksum == 0;  // Keeps the loops from being optimized away
+}
@@ -0,0 +1,166 @@
+#include "core/object/data/DeckTextParser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace
+{
+// utils/helper.h's split, copied because that header pulls in axmol
+std::vector<std::string> split(const std::string& str, char delimiter = ' ')
+{
+    std::vector<std::string> tokens;
+    std::string token;
+    for (char ch : str)
+    {
+        if (ch == delimiter)
+        {
+            if (!token.empty())
+            {
+                tokens.push_back(token);
+                token.clear();
+            }
+        }
+        else
+        {
+            token += ch;
+        }
+    }
+    if (!token.empty())
+    {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+// The config read the way the rest of the game reads text files: split into lines, then into
+// columns, numbers through stoi/stof and sprite paths interned into a map
+struct SplitDeck
+{
+    std::vector<DeckCardRecord> cards;
+    std::string strings;
+};
+
+SplitDeck parseWithSplit(const std::string& text)
+{
+    SplitDeck deck;
+    std::map<std::string, uint32_t> offsets;
+    auto intern = [&](const std::string& path) {
+        auto [it, added] = offsets.emplace(path, uint32_t(deck.strings.size()));
+        if (added)
+        {
+            deck.strings += path;
+            deck.strings.push_back('\0');
+        }
+        return it->second;
+    };
+
+    std::string section;
+    for (auto line : split(text, '\n'))
+    {
+        for (auto& ch : line)
+        {
+            if (ch == '\t' || ch == '\r')
+                ch = ' ';
+        }
+        auto columns = split(line);
+        if (columns.empty() || columns[0][0] == '#')
+            continue;
+        if (columns[0][0] == '[')
+        {
+            section = columns[0];
+            continue;
+        }
+        if (section != "[CARD]" || columns.size() != 9)
+            continue;
+
+        DeckCardRecord card{};
+        card.id          = std::stoi(columns[0]);
+        card.posX        = std::stof(columns[1]);
+        card.posY        = std::stof(columns[2]);
+        card.frontSprite = intern(columns[3]);
+        card.backSprite  = intern(columns[4]);
+        card.sizeX       = std::stof(columns[5]);
+        card.sizeY       = std::stof(columns[6]);
+        card.rotation    = std::stof(columns[7]);
+        card.amount      = uint32_t(std::stoul(columns[8]));
+        deck.cards.push_back(card);
+    }
+    return deck;
+}
+
+bool sameCard(const DeckCardRecord& a, const DeckCardRecord& b)
+{
+    return a.id == b.id && a.posX == b.posX && a.posY == b.posY && a.sizeX == b.sizeX && a.sizeY == b.sizeY &&
+           a.rotation == b.rotation && a.amount == b.amount;
+}
+
+template <typename Parse>
+double nanosecondsPerParse(int iterations, Parse&& parse)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        parse();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+}  // namespace
+
+// CardGameDeckBench [config.txt] [iterations] : times DeckTextParser against the split() path on one config
+int main(int argc, char** argv)
+{
+    std::string path = argc > 1 ? argv[1] : "Content/configs/ascension.txt";
+    int iterations   = argc > 2 ? std::atoi(argv[2]) : 2000;
+    std::ifstream file(path, std::ios::binary);
+    if (!file || iterations <= 0)
+    {
+        std::fprintf(stderr, "Usage: CardGameDeckBench [config.txt] [iterations], cannot read %s\n", path.c_str());
+        return 1;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string text = contents.str();
+
+    // Both have to agree before their times mean anything
+    DeckTextParser parser;
+    if (!parser.parse(text))
+    {
+        std::fprintf(stderr, "%s:%s\n", path.c_str(), parser.getErrorText().c_str());
+        return 1;
+    }
+    auto reference = parseWithSplit(text);
+    if (reference.cards.size() != parser.getCards().size())
+    {
+        std::fprintf(stderr, "split() read %zu cards, DeckTextParser %zu\n", reference.cards.size(),
+                     parser.getCards().size());
+        return 1;
+    }
+    for (size_t i = 0; i < reference.cards.size(); ++i)
+    {
+        auto& expected = reference.cards[i];
+        auto& card     = parser.getCards()[i];
+        if (!sameCard(expected, card) ||
+            parser.getString(card.frontSprite) != reference.strings.c_str() + expected.frontSprite ||
+            parser.getString(card.backSprite) != reference.strings.c_str() + expected.backSprite)
+        {
+            std::fprintf(stderr, "Card %zu differs between the parsers\n", i);
+            return 1;
+        }
+    }
+
+    size_t cards = 0;
+    auto splitTime  = nanosecondsPerParse(iterations, [&] { cards += parseWithSplit(text).cards.size(); });
+    auto parserTime = nanosecondsPerParse(iterations, [&] {
+        parser.parse(text);
+        cards += parser.getCards().size();
+    });
+
+    std::printf("%s: %zu cards, %zu bytes, %d iterations\n", path.c_str(), reference.cards.size(), text.size(),
+                iterations);
+    std::printf("  split()         %10.0f ns per parse\n", splitTime);
+    std::printf("  DeckTextParser  %10.0f ns per parse, %.1fx\n", parserTime, splitTime / parserTime);
+    return cards == 0;  // Keeps the loops from being optimized away
+}
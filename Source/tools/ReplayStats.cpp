@@ -0,0 +1,70 @@
+#include "core/logic/Replayer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+namespace
+{
+// Prints every record as it is replayed, for lining a desynced game up against the server's log
+class RecordPrinter : public ReplayTarget
+{
+public:
+    void onSeed(uint64_t seed) override { std::printf("  seed %llu\n", (unsigned long long)seed); }
+    void onDeal(int32_t cardId, int32_t zoneIndex) override { std::printf("  deal card %d to zone %d\n", cardId, zoneIndex); }
+    void onMove(int32_t playerId, int32_t cardId) override { std::printf("  player %d plays card %d\n", playerId, cardId); }
+};
+}  // namespace
+
+// CardGameReplay [--dump] game.replay... : replays every file headlessly and prints totals
+int main(int argc, char** argv)
+{
+    bool dump = false;
+    size_t games = 0, damaged = 0, desynced = 0, finished = 0, totalMoves = 0;
+    std::map<int32_t, size_t> wins;
+    RecordPrinter printer;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--dump") == 0)
+        {
+            dump = true;
+            continue;
+        }
+
+        Replayer replayer;
+        if (!replayer.load(argv[i]))
+        {
+            std::fprintf(stderr, "%s: %s\n", argv[i], replayer.getError().c_str());
+            ++damaged;
+            continue;
+        }
+        if (dump)
+            std::printf("%s\n", argv[i]);
+        if (!replayer.run(dump ? &printer : nullptr))
+        {
+            std::fprintf(stderr, "%s: %s\n", argv[i], replayer.getError().c_str());
+            ++damaged;
+        }
+
+        auto& summary = replayer.getSummary();
+        if (!summary.desync.empty())
+        {
+            std::fprintf(stderr, "%s: desync, %s\n", argv[i], summary.desync.c_str());
+            ++desynced;
+        }
+        ++games;
+        totalMoves += summary.moves.size();
+        if (summary.winner != -1)
+        {
+            ++finished;
+            ++wins[summary.winner];
+        }
+    }
+
+    std::printf("games %zu, finished %zu, damaged %zu, desynced %zu, average moves %.1f\n", games, finished, damaged,
+                desynced, games ? double(totalMoves) / games : 0.0);
+    for (auto& [player, count] : wins)
+        std::printf("player %d won %zu\n", player, count);
+    return damaged || desynced ? 1 : 0;
+}